@@ -53,6 +53,7 @@
 #include <ti/sysbios/knl/Task.h>
 #include <ti/sysbios/knl/Clock.h>
 #include <ti/sysbios/knl/Semaphore.h>
+#include <ti/sysbios/knl/Swi.h>
 #include <ti/sysbios/knl/Queue.h>
 
 #include <ti/drivers/ADCBuf.h>
@@ -89,6 +90,19 @@
 #include "board.h"
 
 #include "multimeter.h"
+#include "multimeter_acq.h"
+#include "multimeter_reduce.h"
+#include "multimeter_scale.h"
+#include "multimeter_bench.h"
+#include "multimeter_trigger.h"
+#include "multimeter_stats.h"
+#include "multimeter_freq.h"
+#include "multimeter_spectrum.h"
+#include "multimeter_charge.h"
+#include "multimeter_histogram.h"
+#include "multimeter_ohm.h"
+#include "multimeter_continuity.h"
+#include "multimeter_cal.h"
 
 #if defined( USE_FPGA ) || defined( DEBUG_SW_TRACE )
 #include <driverlib/ioc.h>
@@ -130,6 +144,47 @@
 // How often to perform periodic event (in msec)
 #define SBP_PERIODIC_EVT_PERIOD               1000
 
+// Range of the reporting period configurable through characteristic 2 (in msec),
+// the upper limit keeps the period in clock ticks within 32 bits
+#define SBP_PERIODIC_EVT_MIN_PERIOD           10
+#define SBP_PERIODIC_EVT_MAX_PERIOD           36000000
+
+// Extra resolution of the window mean used for mains synchronous readings
+#define SBP_MEAN_FRAC_BITS                    4
+
+// Shortest timer capture period the ADC has to see before a clean signal
+// is timed by the capture, in fractions of a second (the 24-bit capture
+// timer wraps after 350 ms)
+#define SBP_FREQ_CAPTURE_MAX_PERIOD_DIV       4
+
+// Extra resolution of the exponential average across windows
+#define SBP_IIR_FRAC_BITS                     4
+
+// Extra resolution of the DC level and the RMS in the AC modes, and the
+// time constant of the running DC level (in windows, power of 2)
+#define SBP_AC_FRAC_BITS                      4
+#define SBP_AC_DC_SHIFT                       3
+
+// Autorange thresholds (in uV at the input): the 3V range is left above
+// the up threshold, the 10V range below the down threshold
+#define SBP_AUTORANGE_UP_MICROVOLT            2900000
+#define SBP_AUTORANGE_DOWN_MICROVOLT          2600000
+
+// Supply voltage assumed by the resistance mode until the reference scan
+// has measured VDDS (in uV)
+#define SBP_OHM_SUPPLY_MICROVOLT              3300000
+
+// Continuity and diode thresholds, the gap between closing and opening
+// keeps a marginal contact from chattering
+#define SBP_CONTINUITY_CLOSE_OHM              50
+#define SBP_CONTINUITY_OPEN_OHM               100
+#define SBP_DIODE_CLOSE_MICROVOLT             2000000
+#define SBP_DIODE_OPEN_MICROVOLT              2400000
+
+// Longest window in the continuity and diode modes (in msec), a change is
+// notified at the end of the window it happened in
+#define SBP_CONTINUITY_WINDOW_MS              10
+
 // Type of Display to open
 #if !defined(Display_DISABLE_ALL)
   #ifdef USE_CORE_SDK
@@ -157,6 +212,9 @@
 #define SBP_TASK_PRIORITY                     1
 
 
+// The window path nests into the characteristic updates and the display,
+// so their characteristic images and arrays are static rather than on
+// this stack
 #ifndef SBP_TASK_STACK_SIZE
 #define SBP_TASK_STACK_SIZE                   644
 #endif
@@ -166,6 +224,7 @@
 #define SBP_CHAR_CHANGE_EVT                   0x0002
 #define SBP_PERIODIC_EVT                      0x0004
 #define SBP_CONN_EVT_END_EVT                  0x0008
+#define SBP_ADC_WINDOW_EVT                    0x0010
 
 /*********************************************************************
  * TYPEDEFS
@@ -201,8 +260,10 @@ static Clock_Struct periodicClock;
 static Queue_Struct appMsg;
 static Queue_Handle appMsgQueue;
 
-// events flag for internal application events.
-static uint16_t events;
+// events flag for internal application events. The ADC window callback and
+// the clock handler set bits from SWI context, so the task clears them with
+// SWIs disabled.
+static volatile uint16_t events;
 
 // Task configuration
 Task_Struct sbpTask;
@@ -271,16 +332,75 @@ static uint8_t rspTxRetry = 0;
 bool multimeterIsOn = false;
 uint8_t multimeterMode = 0;
 
-/* ADC variables */
-#define ADC_BUFFER_SIZE (100)
-ADCBuf_Handle     adcBuf;
-ADCBuf_Params     adcBufParams;
-ADCBuf_Conversion continuousConversion;
+// Reporting period (in msec), configurable through characteristic 2
+static uint32_t reportPeriod = SBP_PERIODIC_EVT_PERIOD;
+
+// The next reading is the first one after a mode change and is notified
+// as soon as its window completes
+static bool firstReadingPending = false;
+
+// Deadline index of the current report period and the number of report
+// periods that were not serviced before the next deadline
+static volatile uint32_t reportSequence = 0;
+static volatile uint32_t reportOverrunCount = 0;
+
+// Time of the last mode change (in clock ticks) and how long it took until
+// its first reading was notified (in msec)
+static uint32_t modeChangeTicks = 0;
+static uint32_t firstReadingLatency = 0;
+
+// Completion time of the latest window the charge counter integrated (in
+// clock ticks), the next window covers the time from there
+static uint32_t chargeTicks = 0;
+static bool chargeTicksValid = false;
+
+// Range selected by the autorange mode and the number of switches
+static MultimeterMode autorangeMode = MultimeterMode_10V;
+static uint32_t autorangeSwitchCount = 0;
+
+// Range of the resistance mode
+static uint8_t ohmRange = MULTIMETER_OHM_TOP_RANGE;
+
+// Continuity and diode modes: acquisition settings requested before they
+// shortened the window (valid while shortened), a change whose reading was
+// dropped and the latency of the last and the slowest change notification
+// (in usec)
+static multimeterAcqConfig_t continuitySavedConfig;
+static bool continuityConfigSaved = false;
+static bool continuityEdgePending = false;
+static uint32_t continuityLatency = 0;
+static uint32_t continuityMaxLatency = 0;
+
+// Calibration table being received through characteristic 13 and its mode
+static multimeterCalTable_t calStaging = { 0 };
+static uint8_t calStagingMode = MultimeterMode_Count;
+static const multimeterCalTable_t calEmpty = { 0 };
+
 /* ADC conversion result variables */
-uint16_t sampleBufferOne[ADC_BUFFER_SIZE];
-uint32_t microVoltBuffer[ADC_BUFFER_SIZE];
-uint16_t adcValue0;
 uint32_t adcValue0MicroVolt;
+multimeterReduceStats_t adcWindowStats;
+// Cost of the decimation filter in CPU cycles per output sample
+uint32_t decimationCyclesPerOutput = 0;
+// Cost of the true RMS sums in CPU cycles per sample
+uint32_t rmsCyclesPerSample = 0;
+// Cost of the spectrum bins in CPU cycles per window
+uint32_t spectrumCyclesPerWindow = 0;
+// Cost of the histogram in CPU cycles per sample
+uint32_t histogramCyclesPerSample = 0;
+// Reference channels of the latest window (uV), see MultimeterAcqRef
+uint32_t adcRefMicroVolt[MultimeterAcqRef_Count] = { 0 };
+bool adcValue0Valid = false;
+// Reducer of a window to a reading and its parameter, see MultimeterReduceType
+static uint8_t reducerType = MultimeterReduceType_Median;
+static uint8_t reducerParam = 0;
+// Exponential average of the window means in raw codes, SBP_IIR_FRAC_BITS
+// fractional bits on top of the oversampling bits, scaled by 2^reducerParam
+static int32_t iirAccumulator = 0;
+static bool iirValid = false;
+// Running DC level of the AC modes in raw codes, SBP_AC_FRAC_BITS fractional
+// bits on top of the oversampling bits, scaled by 2^SBP_AC_DC_SHIFT
+static int32_t acDcAccumulator = 0;
+static bool acDcValid = false;
 uint8_t value2copy[MULTIMETERPROFILE_CHAR4_LEN] = { 0 };
 
 /* Pin variables */
@@ -310,6 +430,36 @@ static void Multimeter_processAppMsg(sbpEvt_t *pMsg);
 static void Multimeter_processStateChangeEvt(gaprole_States_t newState);
 static void Multimeter_processCharValueChangeEvt(uint8_t paramID);
 static void Multimeter_performPeriodicTask(void);
+static bool Multimeter_processAdcWindow(void);
+static void Multimeter_commitWindow(void);
+static uint32_t Multimeter_freqReading(const multimeterFreqResult_t *pResult);
+static void Multimeter_readingReady(void);
+static MultimeterMode Multimeter_getRange(void);
+static bool Multimeter_autorange(uint32_t adcMicroVolt);
+static void Multimeter_setAutorange(MultimeterMode range);
+static void Multimeter_setOhmRange(uint8_t range);
+static void Multimeter_rangeSwitched(void);
+static uint32_t Multimeter_getSupplyMicroVolt(void);
+static void Multimeter_setFastWindow(bool fast);
+static void Multimeter_setupContinuity(void);
+static void Multimeter_processContinuity(const multimeterAcqWindow_t *pWindow,
+                                         const uint16_t *samples, uint16_t count);
+static void Multimeter_addCharge(const multimeterAcqWindow_t *pWindow, uint32_t sum,
+                                 uint16_t count, uint8_t oversamplingBits);
+static void Multimeter_adcWindowCB(void);
+static void Multimeter_processAcqConfigChange(void);
+static void Multimeter_updateAcqConfigChar(void);
+static void Multimeter_updateStatusChar(void);
+static void Multimeter_processTriggerChange(void);
+static void Multimeter_updateTriggerChar(void);
+static void Multimeter_updateStatsChar(void);
+static void Multimeter_processSpectrumChange(void);
+static void Multimeter_updateSpectrumChar(void);
+static void Multimeter_updateChargeChar(void);
+static void Multimeter_processHistogramChange(void);
+static void Multimeter_updateHistogramChar(void);
+static void Multimeter_processCalibrationChange(void);
+static void Multimeter_setReportPeriod(uint32_t period);
 static void Multimeter_clockHandler(UArg arg);
 static void Multimeter_sendAttRsp(void);
 static void Multimeter_freeAttRsp(uint8_t status);
@@ -412,9 +562,11 @@ static void Multimeter_init(void)
   // Create an RTOS queue for message from profile to be sent to app.
   appMsgQueue = Util_constructQueue(&appMsg);
 
-  // Create one-shot clocks for internal periodic events.
+  // Create a periodic clock for the measurement reports. Its deadlines are
+  // absolute, so the report period does not drift with processing time.
   Util_constructClock(&periodicClock, Multimeter_clockHandler,
-                      SBP_PERIODIC_EVT_PERIOD, 0, false, SBP_PERIODIC_EVT);
+                      SBP_PERIODIC_EVT_PERIOD, SBP_PERIODIC_EVT_PERIOD,
+                      false, SBP_PERIODIC_EVT);
 
   dispHandle = Display_open(SBP_DISPLAY_TYPE, NULL);
 
@@ -526,16 +678,17 @@ static void Multimeter_init(void)
 
   Display_print0(dispHandle, 0, 0, "BLE Peripheral");
 
-  // Init ADC driver
-  ADCBuf_init();
-  ADCBuf_Params_init(&adcBufParams);
-  //adcBufParams.samplingFrequency = 100000;
-  /* Configure the conversion struct */
-  continuousConversion.arg = NULL;
-  continuousConversion.adcChannel = Board_ADCBUFCHANNEL0;
-  continuousConversion.sampleBuffer = sampleBufferOne;
-  continuousConversion.sampleBufferTwo = NULL;
-  continuousConversion.samplesRequestedCount = ADC_BUFFER_SIZE;
+#ifdef MULTIMETER_BENCHMARK
+  MultimeterBench_run(dispHandle);
+#endif // MULTIMETER_BENCHMARK
+
+  // Init ADC acquisition engine
+  MultimeterBench_initCycleCounter();
+  MultimeterAcq_init(Multimeter_adcWindowCB);
+  MultimeterCal_init();
+  Multimeter_updateAcqConfigChar();
+  Multimeter_updateTriggerChar();
+  Multimeter_updateHistogramChar();
 
   /* Open GPIO pins */
   gpioPinHandle = PIN_open(&gpioPinState, gpioPinTable);
@@ -558,6 +711,8 @@ static void Multimeter_init(void)
  */
 static void Multimeter_taskFxn(UArg a0, UArg a1)
 {
+  UInt key;
+
   // Initialize application
   Multimeter_init();
 
@@ -622,11 +777,23 @@ static void Multimeter_taskFxn(UArg a0, UArg a1)
       }
     }
 
+    if (events & SBP_ADC_WINDOW_EVT)
+    {
+      key = Swi_disable();
+      events &= ~SBP_ADC_WINDOW_EVT;
+      Swi_restore(key);
+
+      // Reduce every window queued by the ADC callback
+      while (Multimeter_processAdcWindow())
+      {
+      }
+    }
+
     if (events & SBP_PERIODIC_EVT)
     {
+      key = Swi_disable();
       events &= ~SBP_PERIODIC_EVT;
-
-      Util_startClock(&periodicClock);
+      Swi_restore(key);
 
       // Perform periodic application task
       Multimeter_performPeriodicTask();
@@ -976,14 +1143,19 @@ static void Multimeter_processStateChangeEvt(gaprole_States_t newState)
 
     case GAPROLE_WAITING:
       {
-        if(multimeterIsOn)
+        //the charge counter keeps integrating a current measurement until
+        //the next connection reads it
+        if(multimeterIsOn && multimeterMode != MultimeterMode_500mA &&
+           multimeterMode != MultimeterMode_500mAAC)
         {
             //turn off multimeter
             Util_stopClock(&periodicClock);
             multimeterIsOn = false;
-            //close ADCBuf peripheral
-            ADCBuf_convertCancel(adcBuf);
-            ADCBuf_close(adcBuf);
+            //put ADC acquisition in warm standby
+            MultimeterAcq_standby();
+            Multimeter_setFastWindow(false);
+            adcValue0Valid = false;
+            firstReadingPending = false;
             //reset measurement
             uint8_t charValue4[MULTIMETERPROFILE_CHAR4_LEN] = { 0 };
             MultimeterProfile_SetParameter(MULTIMETERPROFILE_CHAR4, MULTIMETERPROFILE_CHAR4_LEN, charValue4);
@@ -1058,86 +1230,1517 @@ static void Multimeter_processCharValueChangeEvt(uint8_t paramID)
     case MULTIMETERPROFILE_CHAR1:
       MultimeterProfile_GetParameter(MULTIMETERPROFILE_CHAR1, &multimeterMode);
       Display_print1(dispHandle, 4, 0, "Char 1: %d", (uint16_t)multimeterMode);
-      //MultimeterMode_Ohm is currently not supported, handled like closing multimeter
-      if(multimeterMode == MultimeterMode_Off || multimeterMode == MultimeterMode_Ohm)
+      if(multimeterMode == MultimeterMode_Off)
       {
         if (multimeterIsOn) {
           Util_stopClock(&periodicClock);
           //turn off multimeter
           multimeterIsOn = false;
-          //close ADCBuf peripheral
-          ADCBuf_convertCancel(adcBuf);
-          ADCBuf_close(adcBuf);
+          //put ADC acquisition in warm standby
+          MultimeterAcq_standby();
+          Multimeter_setFastWindow(false);
+          adcValue0Valid = false;
+          firstReadingPending = false;
           //reset measurement
           uint8_t charValue4[MULTIMETERPROFILE_CHAR4_LEN] = { 0 };
           MultimeterProfile_SetParameter(MULTIMETERPROFILE_CHAR4, MULTIMETERPROFILE_CHAR4_LEN, charValue4);
           PIN_setOutputValue(gpioPinHandle, Board_DIO21, 0);
           PIN_setOutputValue(gpioPinHandle, Board_DIO22, 0);
+          // the next range switches away from these levels
+          MultimeterAcq_setSwitchLevels(0, 0);
+#ifdef MULTIMETER_FREQ_TIMER_CAPTURE
+          MultimeterFreq_closeCapture();
+#endif // MULTIMETER_FREQ_TIMER_CAPTURE
         }
       }
       else
       {
-        if (!multimeterIsOn) {
-          //turn on multimeter
-          multimeterIsOn = true;
-          Util_startClock(&periodicClock);
-          //opens ADCBuf peripheral
-          adcBuf = ADCBuf_open(Board_ADCBUF0, &adcBufParams);
-          if (adcBuf == NULL) {
-            Display_print0(dispHandle, 0, 0, "Error initializing ADC channel 0\n");
-            while (1);
-          }
-        }
+        //turn on multimeter
+        multimeterIsOn = true;
         //enable\disable required pins according to multimeter mode
         switch (multimeterMode) {
           case MultimeterMode_3V:
+          case MultimeterMode_Frequency:
+          case MultimeterMode_Period:
+          case MultimeterMode_DutyCycle:
             PIN_setOutputValue(gpioPinHandle, Board_DIO21, 0);
             PIN_setOutputValue(gpioPinHandle, Board_DIO22, 0);
             break;
           case MultimeterMode_10V:
+          case MultimeterMode_10VAC:
+            PIN_setOutputValue(gpioPinHandle, Board_DIO21, 0);
+            PIN_setOutputValue(gpioPinHandle, Board_DIO22, 1);
+            break;
+          case MultimeterMode_AutoV:
+            //start on the high range, the first window moves down if needed
+            autorangeMode = MultimeterMode_10V;
             PIN_setOutputValue(gpioPinHandle, Board_DIO21, 0);
             PIN_setOutputValue(gpioPinHandle, Board_DIO22, 1);
             break;
+          case MultimeterMode_Ohm:
+            //start on the largest reference, the lowest drive current
+            ohmRange = MULTIMETER_OHM_TOP_RANGE;
+            PIN_setOutputValue(gpioPinHandle, Board_DIO21, MultimeterOhm_getPins(ohmRange)->dio21);
+            PIN_setOutputValue(gpioPinHandle, Board_DIO22, MultimeterOhm_getPins(ohmRange)->dio22);
+            break;
+          case MultimeterMode_Continuity:
+          case MultimeterMode_Diode:
+            //the lowest reference gives the highest test current
+            ohmRange = 0;
+            PIN_setOutputValue(gpioPinHandle, Board_DIO21, MultimeterOhm_getPins(ohmRange)->dio21);
+            PIN_setOutputValue(gpioPinHandle, Board_DIO22, MultimeterOhm_getPins(ohmRange)->dio22);
+            break;
           case MultimeterMode_500mA:
+          case MultimeterMode_500mAAC:
             PIN_setOutputValue(gpioPinHandle, Board_DIO21, 1);
             break;
         }
+        //the DC level and the statistics are learned again on the new range
+        acDcValid = false;
+        iirValid = false;
+        chargeTicksValid = false;
+        MultimeterStats_reset();
+        Multimeter_updateStatsChar();
+        MultimeterHistogram_restart();
+        MultimeterFreq_reset();
+#ifdef MULTIMETER_FREQ_TIMER_CAPTURE
+        if (multimeterMode == MultimeterMode_Frequency ||
+            multimeterMode == MultimeterMode_Period ||
+            multimeterMode == MultimeterMode_DutyCycle) {
+          VOID MultimeterFreq_openCapture();
+        }
+        else {
+          MultimeterFreq_closeCapture();
+        }
+#endif // MULTIMETER_FREQ_TIMER_CAPTURE
+        Multimeter_setFastWindow(multimeterMode == MultimeterMode_Continuity ||
+                                 multimeterMode == MultimeterMode_Diode);
+        //the resistance mode is ratiometric to VDDS, read with every window
+        if (!MultimeterAcq_requireRefScan(multimeterMode == MultimeterMode_Ohm)) {
+          Display_print0(dispHandle, 0, 0, "Error restarting ADC channel 0\n");
+        }
+        //(re)start the ADC from warm standby so the first window starts
+        //after the switch and the front end transient, its reading is
+        //notified as soon as it completes
+        Util_stopClock(&periodicClock);
+        adcValue0Valid = false;
+        firstReadingPending = true;
+        modeChangeTicks = Clock_getTicks();
+        if (!MultimeterAcq_switchRange(PIN_getOutputValue(Board_DIO21),
+                                       PIN_getOutputValue(Board_DIO22))) {
+          Display_print0(dispHandle, 0, 0, "Error initializing ADC channel 0\n");
+          while (1);
+        }
+        //the thresholds are converted with the ADC open
+        if (multimeterMode == MultimeterMode_Continuity ||
+            multimeterMode == MultimeterMode_Diode) {
+          Multimeter_setupContinuity();
+        }
       }
 
       break;
 
+    case MULTIMETERPROFILE_CHAR2:
+      Multimeter_processAcqConfigChange();
+      break;
+
+    case MULTIMETERPROFILE_CHAR5:
+      Multimeter_processTriggerChange();
+      break;
+
+    case MULTIMETERPROFILE_CHAR7:
+      //the only command is a reset
+      MultimeterStats_reset();
+      Multimeter_updateStatsChar();
+      break;
+
+    case MULTIMETERPROFILE_CHAR8:
+      Multimeter_processSpectrumChange();
+      break;
+
+    case MULTIMETERPROFILE_CHAR10:
+      //the only command is a reset
+      MultimeterCharge_reset();
+      Multimeter_updateChargeChar();
+      break;
+
+    case MULTIMETERPROFILE_CHAR11:
+      Multimeter_processHistogramChange();
+      break;
+
+    case MULTIMETERPROFILE_CHAR13:
+      Multimeter_processCalibrationChange();
+      break;
+
     default:
       // should not reach here!
       break;
   }
 }
 
-uint32_t getMedian(int n, uint32_t x[]) {
-    uint32_t temp;
-    int i, j;
-    // the following two loops sort the array x in ascending order
-    for(i=0; i<n-1; i++) {
-        for(j=i+1; j<n; j++) {
-            if(x[j] < x[i]) {
-                // swap elements
-                temp = x[i];
-                x[i] = x[j];
-                x[j] = temp;
+/*********************************************************************
+ * @fn      Multimeter_processAcqConfigChange
+ *
+ * @brief   Apply a new acquisition configuration written to
+ *          characteristic 2. The ADC is restarted with the new sampling
+ *          frequency and window length and the reporting clock is
+ *          reprogrammed; the connection is not affected.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+static void Multimeter_processAcqConfigChange(void)
+{
+  static uint8_t charValue2[MULTIMETERPROFILE_CHAR2_LEN];
+  uint8_t *p;
+  uint32_t samplingFrequency;
+  uint16_t windowSize;
+  uint8_t oversamplingBits;
+  bool refScan;
+  uint16_t minWindowSize;
+  uint32_t noiseMicroVolt;
+  MultimeterAcqMains mains;
+
+  MultimeterProfile_GetParameter(MULTIMETERPROFILE_CHAR2, charValue2);
+
+  p = &charValue2[MULTIMETERPROFILE_CHAR2_FREQUENCY_OFFSET];
+  samplingFrequency = BUILD_UINT32(p[3], p[2], p[1], p[0]);
+  p = &charValue2[MULTIMETERPROFILE_CHAR2_WINDOW_OFFSET];
+  windowSize = BUILD_UINT16(p[1], p[0]);
+  p = &charValue2[MULTIMETERPROFILE_CHAR2_PERIOD_OFFSET];
+  reportPeriod = BUILD_UINT32(p[3], p[2], p[1], p[0]);
+  oversamplingBits = charValue2[MULTIMETERPROFILE_CHAR2_OVERSAMPLING_OFFSET];
+  refScan = (charValue2[MULTIMETERPROFILE_CHAR2_FLAGS_OFFSET] &
+             MULTIMETERPROFILE_CHAR2_FLAG_REF_SCAN) != 0;
+  p = &charValue2[MULTIMETERPROFILE_CHAR2_MIN_WINDOW_OFFSET];
+  minWindowSize = BUILD_UINT16(p[1], p[0]);
+  p = &charValue2[MULTIMETERPROFILE_CHAR2_NOISE_OFFSET];
+  noiseMicroVolt = BUILD_UINT32(p[3], p[2], p[1], p[0]);
+  mains = (MultimeterAcqMains)charValue2[MULTIMETERPROFILE_CHAR2_MAINS_OFFSET];
+  reducerType = charValue2[MULTIMETERPROFILE_CHAR2_REDUCER_OFFSET];
+  reducerParam = charValue2[MULTIMETERPROFILE_CHAR2_REDUCER_PARAM_OFFSET];
+
+  if (reportPeriod < SBP_PERIODIC_EVT_MIN_PERIOD)
+  {
+    reportPeriod = SBP_PERIODIC_EVT_MIN_PERIOD;
+  }
+  else if (reportPeriod > SBP_PERIODIC_EVT_MAX_PERIOD)
+  {
+    reportPeriod = SBP_PERIODIC_EVT_MAX_PERIOD;
+  }
+
+  Multimeter_setReportPeriod(reportPeriod);
+
+  switch (reducerType)
+  {
+    case MultimeterReduceType_TrimmedMean:
+      if (reducerParam > MULTIMETER_REDUCE_MAX_TRIM)
+      {
+        reducerParam = MULTIMETER_REDUCE_MAX_TRIM;
+      }
+      break;
+
+    case MultimeterReduceType_Hampel:
+      if (reducerParam < MULTIMETER_REDUCE_MIN_HAMPEL)
+      {
+        reducerParam = MULTIMETER_REDUCE_DEFAULT_HAMPEL;
+      }
+      break;
+
+    case MultimeterReduceType_Iir:
+      if (reducerParam > MULTIMETER_REDUCE_MAX_IIR_SHIFT)
+      {
+        reducerParam = MULTIMETER_REDUCE_MAX_IIR_SHIFT;
+      }
+      break;
+
+    default:
+      reducerType = MultimeterReduceType_Median;
+      reducerParam = 0;
+      break;
+  }
+  // the average restarts, the resolution of the codes may change
+  iirValid = false;
+  // the window written by the client stays in use after the fast modes
+  continuityConfigSaved = false;
+
+  if (!MultimeterAcq_configure(samplingFrequency, windowSize, oversamplingBits, refScan, mains) ||
+      !MultimeterAcq_setAdaptiveWindow(minWindowSize, noiseMicroVolt))
+  {
+    Display_print0(dispHandle, 0, 0, "Error restarting ADC channel 0\n");
+  }
+
+  if (multimeterIsOn)
+  {
+    Util_startClock(&periodicClock);
+  }
+
+  // Report the values actually in use after clamping
+  Multimeter_updateAcqConfigChar();
+
+  Display_print3(dispHandle, 4, 0, "Acq: %d Hz, %d smp, %d ms",
+                 MultimeterAcq_getSamplingFrequency(),
+                 MultimeterAcq_getWindowSize(), reportPeriod);
+}
+
+/*********************************************************************
+ * @fn      Multimeter_setReportPeriod
+ *
+ * @brief   Reprogram the periodic report clock. The clock is left stopped.
+ *
+ * @param   period - report period (in msec).
+ *
+ * @return  None.
+ */
+static void Multimeter_setReportPeriod(uint32_t period)
+{
+  uint32_t ticks = period * (1000 / Clock_tickPeriod);
+
+  // The clock must be stopped while its timeout and period are changed
+  Util_stopClock(&periodicClock);
+  Clock_setTimeout(Clock_handle(&periodicClock), ticks);
+  Clock_setPeriod(Clock_handle(&periodicClock), ticks);
+}
+
+/*********************************************************************
+ * @fn      Multimeter_processTriggerChange
+ *
+ * @brief   Arm the trigger with the configuration written to
+ *          characteristic 5. Any previous capture is dropped.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+static void Multimeter_processTriggerChange(void)
+{
+  static uint8_t charValue5[MULTIMETERPROFILE_CHAR5_LEN];
+  multimeterTriggerConfig_t config;
+  uint8_t *p;
+
+  MultimeterProfile_GetParameter(MULTIMETERPROFILE_CHAR5, charValue5);
+
+  config.type = charValue5[MULTIMETERPROFILE_CHAR5_TYPE_OFFSET];
+  config.slope = charValue5[MULTIMETERPROFILE_CHAR5_SLOPE_OFFSET];
+  p = &charValue5[MULTIMETERPROFILE_CHAR5_LEVEL_OFFSET];
+  config.level = BUILD_UINT16(p[1], p[0]);
+  p = &charValue5[MULTIMETERPROFILE_CHAR5_HIGH_LEVEL_OFFSET];
+  config.highLevel = BUILD_UINT16(p[1], p[0]);
+  p = &charValue5[MULTIMETERPROFILE_CHAR5_PRE_OFFSET];
+  config.preSamples = BUILD_UINT16(p[1], p[0]);
+  p = &charValue5[MULTIMETERPROFILE_CHAR5_POST_OFFSET];
+  config.postSamples = BUILD_UINT16(p[1], p[0]);
+
+  // The capture buffer is about to be reused
+  MultimeterProfile_SetLongParameter(MULTIMETERPROFILE_CHAR6, 0, NULL);
+  MultimeterTrigger_arm(&config);
+
+  // Report the values actually in use after clamping
+  Multimeter_updateTriggerChar();
+
+  Display_print1(dispHandle, 8, 0, "Trigger: state %d", (uint16_t)MultimeterTrigger_getState());
+}
+
+/*********************************************************************
+ * @fn      Multimeter_updateTriggerChar
+ *
+ * @brief   Write the trigger configuration and state to characteristic 5.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+static void Multimeter_updateTriggerChar(void)
+{
+  static uint8_t charValue5[MULTIMETERPROFILE_CHAR5_LEN];
+  multimeterTriggerConfig_t config;
+  uint8_t *p;
+
+  MultimeterTrigger_getConfig(&config);
+
+  charValue5[MULTIMETERPROFILE_CHAR5_TYPE_OFFSET] = config.type;
+  charValue5[MULTIMETERPROFILE_CHAR5_SLOPE_OFFSET] = config.slope;
+  p = &charValue5[MULTIMETERPROFILE_CHAR5_LEVEL_OFFSET];
+  p[0] = HI_UINT16(config.level);
+  p[1] = LO_UINT16(config.level);
+  p = &charValue5[MULTIMETERPROFILE_CHAR5_HIGH_LEVEL_OFFSET];
+  p[0] = HI_UINT16(config.highLevel);
+  p[1] = LO_UINT16(config.highLevel);
+  p = &charValue5[MULTIMETERPROFILE_CHAR5_PRE_OFFSET];
+  p[0] = HI_UINT16(config.preSamples);
+  p[1] = LO_UINT16(config.preSamples);
+  p = &charValue5[MULTIMETERPROFILE_CHAR5_POST_OFFSET];
+  p[0] = HI_UINT16(config.postSamples);
+  p[1] = LO_UINT16(config.postSamples);
+  charValue5[MULTIMETERPROFILE_CHAR5_STATE_OFFSET] = (uint8_t)MultimeterTrigger_getState();
+
+  MultimeterProfile_SetParameter(MULTIMETERPROFILE_CHAR5, MULTIMETERPROFILE_CHAR5_LEN, charValue5);
+}
+
+/*********************************************************************
+ * @fn      Multimeter_updateStatusChar
+ *
+ * @brief   Write the scheduler and acquisition counters to characteristic 3.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+static void Multimeter_updateStatusChar(void)
+{
+  static uint8_t charValue3[MULTIMETERPROFILE_CHAR3_LEN];
+  multimeterAcqSettle_t settle;
+  uint8_t *p;
+  uint32_t value;
+
+  value = reportSequence;
+  p = &charValue3[MULTIMETERPROFILE_CHAR3_SEQUENCE_OFFSET];
+  p[0] = BREAK_UINT32(value, 3);
+  p[1] = BREAK_UINT32(value, 2);
+  p[2] = BREAK_UINT32(value, 1);
+  p[3] = BREAK_UINT32(value, 0);
+
+  value = reportOverrunCount;
+  p = &charValue3[MULTIMETERPROFILE_CHAR3_REPORT_OVERRUN_OFFSET];
+  p[0] = BREAK_UINT32(value, 3);
+  p[1] = BREAK_UINT32(value, 2);
+  p[2] = BREAK_UINT32(value, 1);
+  p[3] = BREAK_UINT32(value, 0);
+
+  value = MultimeterAcq_getOverrunCount();
+  p = &charValue3[MULTIMETERPROFILE_CHAR3_ACQ_OVERRUN_OFFSET];
+  p[0] = BREAK_UINT32(value, 3);
+  p[1] = BREAK_UINT32(value, 2);
+  p[2] = BREAK_UINT32(value, 1);
+  p[3] = BREAK_UINT32(value, 0);
+
+  value = MultimeterAcq_getOverflowCount();
+  p = &charValue3[MULTIMETERPROFILE_CHAR3_ACQ_OVERFLOW_OFFSET];
+  p[0] = BREAK_UINT32(value, 3);
+  p[1] = BREAK_UINT32(value, 2);
+  p[2] = BREAK_UINT32(value, 1);
+  p[3] = BREAK_UINT32(value, 0);
+
+  value = MultimeterAcq_getCurrentWindowSize();
+  p = &charValue3[MULTIMETERPROFILE_CHAR3_WINDOW_OFFSET];
+  p[0] = HI_UINT16(value);
+  p[1] = LO_UINT16(value);
+
+  charValue3[MULTIMETERPROFILE_CHAR3_MAINS_OFFSET] = MultimeterAcq_getMainsFrequency();
+
+  value = continuityLatency;
+  p = &charValue3[MULTIMETERPROFILE_CHAR3_EDGE_LATENCY_OFFSET];
+  p[0] = BREAK_UINT32(value, 3);
+  p[1] = BREAK_UINT32(value, 2);
+  p[2] = BREAK_UINT32(value, 1);
+  p[3] = BREAK_UINT32(value, 0);
+
+  value = continuityMaxLatency;
+  p = &charValue3[MULTIMETERPROFILE_CHAR3_MAX_LATENCY_OFFSET];
+  p[0] = BREAK_UINT32(value, 3);
+  p[1] = BREAK_UINT32(value, 2);
+  p[2] = BREAK_UINT32(value, 1);
+  p[3] = BREAK_UINT32(value, 0);
+
+  MultimeterAcq_getSettle(&settle);
+
+  value = settle.lastCost;
+  p = &charValue3[MULTIMETERPROFILE_CHAR3_SWITCH_COST_OFFSET];
+  p[0] = BREAK_UINT32(value, 3);
+  p[1] = BREAK_UINT32(value, 2);
+  p[2] = BREAK_UINT32(value, 1);
+  p[3] = BREAK_UINT32(value, 0);
+
+  value = settle.maxCost;
+  p = &charValue3[MULTIMETERPROFILE_CHAR3_MAX_SWITCH_COST_OFFSET];
+  p[0] = BREAK_UINT32(value, 3);
+  p[1] = BREAK_UINT32(value, 2);
+  p[2] = BREAK_UINT32(value, 1);
+  p[3] = BREAK_UINT32(value, 0);
+
+  value = settle.discardedSamples;
+  p = &charValue3[MULTIMETERPROFILE_CHAR3_SETTLE_DISCARDED_OFFSET];
+  p[0] = BREAK_UINT32(value, 3);
+  p[1] = BREAK_UINT32(value, 2);
+  p[2] = BREAK_UINT32(value, 1);
+  p[3] = BREAK_UINT32(value, 0);
+
+  MultimeterProfile_SetParameter(MULTIMETERPROFILE_CHAR3, MULTIMETERPROFILE_CHAR3_LEN, charValue3);
+}
+
+/*********************************************************************
+ * @fn      Multimeter_updateStatsChar
+ *
+ * @brief   Publish the sample statistics in characteristic 7, converted
+ *          with the scale of the current mode.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+static void Multimeter_updateStatsChar(void)
+{
+  static uint8_t charValue7[MULTIMETERPROFILE_CHAR7_LEN];
+  static uint32_t values[MULTIMETERPROFILE_CHAR7_LEN / 4];
+  static multimeterStatsSummary_t summary;
+  MultimeterMode mode = Multimeter_getRange();
+  uint32_t microVolt;
+  uint8_t *p;
+  uint8_t i;
+
+  memset(values, 0, sizeof(values));
+  if (MultimeterStats_get(&summary)) {
+    values[MULTIMETERPROFILE_CHAR7_COUNT_OFFSET / 4] = summary.count;
+
+    if (MultimeterAcq_codeToMicroVolts(summary.mean, MULTIMETER_STATS_MEAN_FRAC_BITS, &microVolt)) {
+      values[MULTIMETERPROFILE_CHAR7_MEAN_OFFSET / 4] = (uint32_t)MultimeterScale_apply(mode, microVolt);
+    }
+    // a spread only goes through the gain of the range
+    if (MultimeterAcq_codeSpanToMicroVolts(summary.stdDev, MULTIMETER_STATS_STD_DEV_FRAC_BITS, &microVolt)) {
+      values[MULTIMETERPROFILE_CHAR7_STD_DEV_OFFSET / 4] =
+        (uint32_t)(MultimeterScale_apply(mode, microVolt) - MultimeterScale_apply(mode, 0));
+    }
+    if (MultimeterAcq_codeToMicroVolts(summary.min, 0, &microVolt)) {
+      values[MULTIMETERPROFILE_CHAR7_MIN_OFFSET / 4] = (uint32_t)MultimeterScale_apply(mode, microVolt);
+    }
+    if (MultimeterAcq_codeToMicroVolts(summary.max, 0, &microVolt)) {
+      values[MULTIMETERPROFILE_CHAR7_MAX_OFFSET / 4] = (uint32_t)MultimeterScale_apply(mode, microVolt);
+    }
+  }
+
+  for (i = 0; i < MULTIMETERPROFILE_CHAR7_LEN / 4; i++) {
+    p = &charValue7[i * 4];
+    p[0] = BREAK_UINT32(values[i], 3);
+    p[1] = BREAK_UINT32(values[i], 2);
+    p[2] = BREAK_UINT32(values[i], 1);
+    p[3] = BREAK_UINT32(values[i], 0);
+  }
+
+  MultimeterProfile_SetParameter(MULTIMETERPROFILE_CHAR7, MULTIMETERPROFILE_CHAR7_LEN, charValue7);
+}
+
+/*********************************************************************
+ * @fn      Multimeter_processSpectrumChange
+ *
+ * @brief   Select the spectrum bins written to characteristic 8.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+static void Multimeter_processSpectrumChange(void)
+{
+  static uint8_t charValue8[MULTIMETERPROFILE_CHAR8_LEN];
+  static uint32_t frequencies[MULTIMETER_SPECTRUM_MAX_BINS];
+  uint8_t *p;
+  uint8_t count = 0;
+  uint8_t i;
+
+  MultimeterProfile_GetParameter(MULTIMETERPROFILE_CHAR8, charValue8);
+
+  // The list ends at the first 0
+  while (count < MULTIMETER_SPECTRUM_MAX_BINS) {
+    p = &charValue8[count * MULTIMETERPROFILE_CHAR8_BIN_SIZE];
+    frequencies[count] = BUILD_UINT32(p[3], p[2], p[1], p[0]);
+    if (frequencies[count] == 0) {
+      break;
+    }
+    count++;
+  }
+  VOID MultimeterSpectrum_setBins(frequencies, count);
+
+  // Report the bins in use and drop the amplitudes of the old ones
+  memset(charValue8, 0, sizeof(charValue8));
+  for (i = 0; i < count; i++) {
+    p = &charValue8[i * MULTIMETERPROFILE_CHAR8_BIN_SIZE];
+    p[0] = BREAK_UINT32(frequencies[i], 3);
+    p[1] = BREAK_UINT32(frequencies[i], 2);
+    p[2] = BREAK_UINT32(frequencies[i], 1);
+    p[3] = BREAK_UINT32(frequencies[i], 0);
+  }
+  MultimeterProfile_SetParameter(MULTIMETERPROFILE_CHAR8, MULTIMETERPROFILE_CHAR8_LEN, charValue8);
+  Multimeter_updateSpectrumChar();
+}
+
+/*********************************************************************
+ * @fn      Multimeter_updateSpectrumChar
+ *
+ * @brief   Publish the spectrum amplitudes of the latest window in
+ *          characteristic 9, converted with the gain of the current mode.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+static void Multimeter_updateSpectrumChar(void)
+{
+  static uint8_t charValue9[MULTIMETERPROFILE_CHAR9_LEN];
+  static uint32_t amplitudes[MULTIMETER_SPECTRUM_MAX_BINS];
+  MultimeterMode mode = Multimeter_getRange();
+  uint32_t microVolt;
+  uint32_t value;
+  uint8_t *p;
+  uint8_t count;
+  uint8_t i;
+
+  memset(charValue9, 0, sizeof(charValue9));
+  count = MultimeterSpectrum_getAmplitudes(amplitudes);
+  for (i = 0; i < count; i++) {
+    value = 0;
+    if (amplitudes[i] > 0 &&
+        MultimeterAcq_codeSpanToMicroVolts(amplitudes[i], MULTIMETER_SPECTRUM_AMPLITUDE_FRAC_BITS, &microVolt)) {
+      value = (uint32_t)(MultimeterScale_apply(mode, microVolt) - MultimeterScale_apply(mode, 0));
+    }
+    p = &charValue9[i * MULTIMETERPROFILE_CHAR8_BIN_SIZE];
+    p[0] = BREAK_UINT32(value, 3);
+    p[1] = BREAK_UINT32(value, 2);
+    p[2] = BREAK_UINT32(value, 1);
+    p[3] = BREAK_UINT32(value, 0);
+  }
+
+  MultimeterProfile_SetParameter(MULTIMETERPROFILE_CHAR9, MULTIMETERPROFILE_CHAR9_LEN, charValue9);
+}
+
+/*********************************************************************
+ * @fn      Multimeter_updateChargeChar
+ *
+ * @brief   Publish the charge and energy totals in characteristic 10.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+static void Multimeter_updateChargeChar(void)
+{
+  static uint8_t charValue10[MULTIMETERPROFILE_CHAR10_LEN];
+  static uint32_t values[MULTIMETERPROFILE_CHAR10_LEN / 4];
+  static multimeterChargeSummary_t summary;
+  uint8_t *p;
+  uint8_t i;
+
+  MultimeterCharge_get(&summary);
+  values[MULTIMETERPROFILE_CHAR10_CHARGE_OFFSET / 4] = (uint32_t)summary.microAmpHours;
+  values[MULTIMETERPROFILE_CHAR10_ENERGY_OFFSET / 4] = (uint32_t)summary.microWattHours;
+  values[MULTIMETERPROFILE_CHAR10_VOLTAGE_OFFSET / 4] = (uint32_t)summary.microVolt;
+  values[MULTIMETERPROFILE_CHAR10_TIME_OFFSET / 4] = summary.seconds;
+
+  for (i = 0; i < MULTIMETERPROFILE_CHAR10_LEN / 4; i++) {
+    p = &charValue10[i * 4];
+    p[0] = BREAK_UINT32(values[i], 3);
+    p[1] = BREAK_UINT32(values[i], 2);
+    p[2] = BREAK_UINT32(values[i], 1);
+    p[3] = BREAK_UINT32(values[i], 0);
+  }
+
+  MultimeterProfile_SetParameter(MULTIMETERPROFILE_CHAR10, MULTIMETERPROFILE_CHAR10_LEN, charValue10);
+}
+
+/*********************************************************************
+ * @fn      Multimeter_processHistogramChange
+ *
+ * @brief   Apply the histogram setup written to characteristic 11.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+static void Multimeter_processHistogramChange(void)
+{
+  static uint8_t charValue11[MULTIMETERPROFILE_CHAR11_LEN];
+  multimeterHistogramConfig_t config;
+  uint8_t *p;
+
+  MultimeterProfile_GetParameter(MULTIMETERPROFILE_CHAR11, charValue11);
+
+  p = &charValue11[MULTIMETERPROFILE_CHAR11_FIRST_CODE_OFFSET];
+  config.firstCode = BUILD_UINT16(p[1], p[0]);
+  config.widthShift = charValue11[MULTIMETERPROFILE_CHAR11_WIDTH_OFFSET];
+  config.bins = charValue11[MULTIMETERPROFILE_CHAR11_BINS_OFFSET];
+  p = &charValue11[MULTIMETERPROFILE_CHAR11_WINDOWS_OFFSET];
+  config.windows = BUILD_UINT16(p[1], p[0]);
+
+  // The packed histogram is about to be dropped
+  if (MultimeterHistogram_configure(&config)) {
+    MultimeterProfile_SetLongParameter(MULTIMETERPROFILE_CHAR12, 0, NULL);
+  }
+
+  // Report the setup actually in use
+  Multimeter_updateHistogramChar();
+}
+
+/*********************************************************************
+ * @fn      Multimeter_updateHistogramChar
+ *
+ * @brief   Write the histogram setup in use to characteristic 11.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+static void Multimeter_updateHistogramChar(void)
+{
+  static uint8_t charValue11[MULTIMETERPROFILE_CHAR11_LEN];
+  multimeterHistogramConfig_t config;
+  uint8_t *p;
+
+  MultimeterHistogram_getConfig(&config);
+
+  p = &charValue11[MULTIMETERPROFILE_CHAR11_FIRST_CODE_OFFSET];
+  p[0] = HI_UINT16(config.firstCode);
+  p[1] = LO_UINT16(config.firstCode);
+  charValue11[MULTIMETERPROFILE_CHAR11_WIDTH_OFFSET] = config.widthShift;
+  charValue11[MULTIMETERPROFILE_CHAR11_BINS_OFFSET] = config.bins;
+  p = &charValue11[MULTIMETERPROFILE_CHAR11_WINDOWS_OFFSET];
+  p[0] = HI_UINT16(config.windows);
+  p[1] = LO_UINT16(config.windows);
+
+  MultimeterProfile_SetParameter(MULTIMETERPROFILE_CHAR11, MULTIMETERPROFILE_CHAR11_LEN, charValue11);
+}
+
+/*********************************************************************
+ * @fn      Multimeter_processCalibrationChange
+ *
+ * @brief   Apply a calibration point, commit or clear written to
+ *          characteristic 13. Points are taken in order, index 0
+ *          starting a new table.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+static void Multimeter_processCalibrationChange(void)
+{
+  static uint8_t charValue13[MULTIMETERPROFILE_CHAR13_LEN];
+  uint8_t mode;
+  uint8_t index;
+  uint8_t *p;
+  bool accepted = false;
+
+  MultimeterProfile_GetParameter(MULTIMETERPROFILE_CHAR13, charValue13);
+
+  mode = charValue13[MULTIMETERPROFILE_CHAR13_MODE_OFFSET];
+  index = charValue13[MULTIMETERPROFILE_CHAR13_INDEX_OFFSET];
+
+  if (mode < MultimeterMode_Count) {
+    if (index < MULTIMETER_CAL_MAX_POINTS) {
+      if (index == 0) {
+        calStaging.count = 0;
+        calStagingMode = mode;
+      }
+      if (mode == calStagingMode && index == calStaging.count) {
+        p = &charValue13[MULTIMETERPROFILE_CHAR13_INPUT_OFFSET];
+        calStaging.input[index] = (int32_t)BUILD_UINT32(p[3], p[2], p[1], p[0]);
+        p = &charValue13[MULTIMETERPROFILE_CHAR13_OUTPUT_OFFSET];
+        calStaging.output[index] = (int32_t)BUILD_UINT32(p[3], p[2], p[1], p[0]);
+        calStaging.count++;
+        accepted = true;
+      }
+      index = calStaging.count;
+    } else if (index == MULTIMETERPROFILE_CHAR13_COMMIT) {
+      // Written to SNV only once all the points are in
+      if (mode == calStagingMode &&
+          MultimeterCal_setTable((MultimeterMode)mode, &calStaging)) {
+        calStagingMode = MultimeterMode_Count;
+        accepted = true;
+      }
+      index = MultimeterCal_getCount((MultimeterMode)mode);
+    } else if (index == MULTIMETERPROFILE_CHAR13_CLEAR) {
+      accepted = MultimeterCal_setTable((MultimeterMode)mode, &calEmpty);
+      index = MultimeterCal_getCount((MultimeterMode)mode);
+    }
+  }
+
+  if (!accepted) {
+    mode = 0xFF;
+  }
+  charValue13[MULTIMETERPROFILE_CHAR13_MODE_OFFSET] = mode;
+  charValue13[MULTIMETERPROFILE_CHAR13_INDEX_OFFSET] = index;
+
+  MultimeterProfile_SetParameter(MULTIMETERPROFILE_CHAR13, MULTIMETERPROFILE_CHAR13_LEN, charValue13);
+}
+
+/*********************************************************************
+ * @fn      Multimeter_updateAcqConfigChar
+ *
+ * @brief   Write the acquisition configuration in use to characteristic 2.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+static void Multimeter_updateAcqConfigChar(void)
+{
+  static uint8_t charValue2[MULTIMETERPROFILE_CHAR2_LEN];
+  uint8_t *p;
+  uint32_t samplingFrequency = MultimeterAcq_getSamplingFrequency();
+  uint16_t windowSize = MultimeterAcq_getWindowSize();
+  uint16_t minWindowSize = MultimeterAcq_getMinWindowSize();
+  uint32_t noiseMicroVolt = MultimeterAcq_getNoiseTarget();
+
+  p = &charValue2[MULTIMETERPROFILE_CHAR2_FREQUENCY_OFFSET];
+  p[0] = BREAK_UINT32(samplingFrequency, 3);
+  p[1] = BREAK_UINT32(samplingFrequency, 2);
+  p[2] = BREAK_UINT32(samplingFrequency, 1);
+  p[3] = BREAK_UINT32(samplingFrequency, 0);
+
+  p = &charValue2[MULTIMETERPROFILE_CHAR2_WINDOW_OFFSET];
+  p[0] = HI_UINT16(windowSize);
+  p[1] = LO_UINT16(windowSize);
+
+  p = &charValue2[MULTIMETERPROFILE_CHAR2_PERIOD_OFFSET];
+  p[0] = BREAK_UINT32(reportPeriod, 3);
+  p[1] = BREAK_UINT32(reportPeriod, 2);
+  p[2] = BREAK_UINT32(reportPeriod, 1);
+  p[3] = BREAK_UINT32(reportPeriod, 0);
+
+  charValue2[MULTIMETERPROFILE_CHAR2_OVERSAMPLING_OFFSET] = MultimeterAcq_getOversamplingBits();
+  charValue2[MULTIMETERPROFILE_CHAR2_FLAGS_OFFSET] =
+    MultimeterAcq_getRefScan() ? MULTIMETERPROFILE_CHAR2_FLAG_REF_SCAN : 0;
+
+  p = &charValue2[MULTIMETERPROFILE_CHAR2_MIN_WINDOW_OFFSET];
+  p[0] = HI_UINT16(minWindowSize);
+  p[1] = LO_UINT16(minWindowSize);
+
+  p = &charValue2[MULTIMETERPROFILE_CHAR2_NOISE_OFFSET];
+  p[0] = BREAK_UINT32(noiseMicroVolt, 3);
+  p[1] = BREAK_UINT32(noiseMicroVolt, 2);
+  p[2] = BREAK_UINT32(noiseMicroVolt, 1);
+  p[3] = BREAK_UINT32(noiseMicroVolt, 0);
+
+  charValue2[MULTIMETERPROFILE_CHAR2_MAINS_OFFSET] = (uint8_t)MultimeterAcq_getMains();
+  charValue2[MULTIMETERPROFILE_CHAR2_REDUCER_OFFSET] = reducerType;
+  charValue2[MULTIMETERPROFILE_CHAR2_REDUCER_PARAM_OFFSET] = reducerParam;
+
+  MultimeterProfile_SetParameter(MULTIMETERPROFILE_CHAR2, MULTIMETERPROFILE_CHAR2_LEN, charValue2);
+}
+
+/*********************************************************************
+ * @fn      Multimeter_processAdcWindow
+ *
+ * @brief   Reduce the oldest window queued by the acquisition engine to a
+ *          single reading. Runs in task context while the ADC keeps
+ *          filling the other buffer.
+ *
+ * @param   None.
+ *
+ * @return  true if a window was taken, false if the queue was empty.
+ */
+static bool Multimeter_processAdcWindow(void)
+{
+    multimeterAcqWindow_t window;
+    uint16_t sampleCount;
+    uint16_t *sampleBuffer;
+    uint8_t oversamplingBits = MultimeterAcq_getOversamplingBits();
+    uint32_t cycles;
+    uint32_t readingCode = 0;
+    uint8_t readingFracBits;
+    bool acMode = (multimeterMode == MultimeterMode_10VAC ||
+                   multimeterMode == MultimeterMode_500mAAC);
+    bool freqMode = (multimeterMode == MultimeterMode_Frequency ||
+                     multimeterMode == MultimeterMode_Period ||
+                     multimeterMode == MultimeterMode_DutyCycle);
+    multimeterFreqResult_t freqResult;
+    uint32_t acSum = 0;
+    uint64_t acSumSquares = 0;
+    int32_t acDcCode;
+    bool converted;
+    uint8_t i;
+
+    if (!MultimeterAcq_getWindow(&window)) {
+      return false;
+    }
+    sampleBuffer = window.samples;
+    sampleCount = window.count;
+
+    // every rate and mean below divides by the number of samples
+    if (sampleCount == 0) {
+        return true;
+    }
+
+    // in auto mains mode the first window only tells 50 from 60 Hz
+    if (MultimeterAcq_detectMains(sampleBuffer, sampleCount)) {
+        Multimeter_updateAcqConfigChar();
+        Display_print1(dispHandle, 4, 0, "Mains: %d Hz", MultimeterAcq_getMainsFrequency());
+        return true;
+    }
+
+    // run the trigger on the raw codes, before decimation rewrites them
+    if (MultimeterTrigger_process(sampleBuffer, sampleCount)) {
+        const uint8_t *pCapture;
+        uint16_t captureLen;
+
+        // the capture stays frozen until the trigger is armed again
+        pCapture = MultimeterTrigger_getCapture(&captureLen);
+        MultimeterProfile_SetLongParameter(MULTIMETERPROFILE_CHAR6, captureLen, pCapture);
+        Multimeter_updateTriggerChar();
+        Display_print1(dispHandle, 8, 0, "Trigger: captured %d samples", captureLen / 2);
+    }
+
+    // statistics see every raw sample, not only the reduced readings, and
+    // so does the histogram. Both only count the window once its release
+    // shows the samples were intact.
+    MultimeterStats_processWindow(sampleBuffer, sampleCount);
+    cycles = MULTIMETER_BENCH_CYCLES();
+    MultimeterHistogram_process(sampleBuffer, sampleCount);
+    histogramCyclesPerSample = (MULTIMETER_BENCH_CYCLES() - cycles) / sampleCount;
+
+    // amplitudes of the selected frequencies, on the full bandwidth
+    if (MultimeterSpectrum_getBins(NULL) > 0) {
+        cycles = MULTIMETER_BENCH_CYCLES();
+        MultimeterSpectrum_process(sampleBuffer, sampleCount, MultimeterAcq_getSamplingFrequency());
+        spectrumCyclesPerWindow = MULTIMETER_BENCH_CYCLES() - cycles;
+    }
+
+    if (freqMode) {
+        // crossings are timed on the raw stream at the full sample rate,
+        // a reading is ready once a cycle completed or the signal timed out
+        MultimeterFreq_process(sampleBuffer, sampleCount, MultimeterAcq_getSamplingFrequency());
+        if (!MultimeterAcq_releaseWindow(&window)) {
+            // the crossings may come from torn samples
+            MultimeterFreq_rollback();
+            return true;
+        }
+        Multimeter_commitWindow();
+        if (MultimeterFreq_get(&freqResult, MultimeterAcq_getSamplingFrequency())) {
+            adcValue0MicroVolt = Multimeter_freqReading(&freqResult);
+            Multimeter_readingReady();
+        }
+        return true;
+    }
+
+    if (multimeterMode == MultimeterMode_Continuity || multimeterMode == MultimeterMode_Diode) {
+        // the detector sees every raw sample, no reducer in between
+        Multimeter_processContinuity(&window, sampleBuffer, sampleCount);
+        return true;
+    }
+
+    if (oversamplingBits > 0) {
+      // oversample and decimate in place for extra resolution
+      cycles = MULTIMETER_BENCH_CYCLES();
+      sampleCount = MultimeterReduce_decimate(sampleBuffer, sampleCount, oversamplingBits);
+      if (sampleCount == 0) {
+          // less than one oversampling group, nothing to reduce
+          if (MultimeterAcq_releaseWindow(&window)) {
+              Multimeter_commitWindow();
+          }
+          return true;
+      }
+      decimationCyclesPerOutput = (MULTIMETER_BENCH_CYCLES() - cycles) / sampleCount;
+    }
+
+    if (acMode) {
+        // true RMS only needs the two sums, a single pass without branches
+        cycles = MULTIMETER_BENCH_CYCLES();
+        MultimeterReduce_sumSquares(sampleBuffer, sampleCount, &acSum, &acSumSquares);
+        rmsCyclesPerSample = (MULTIMETER_BENCH_CYCLES() - cycles) / sampleCount;
+    }
+    else {
+        // reduce directly on the raw codes, linear in the window size
+        MultimeterReduce_window(sampleBuffer, sampleCount,
+                                MULTIMETER_REDUCE_CODE_BITS + oversamplingBits, &adcWindowStats);
+
+        // the robust means need the samples once more
+        if (reducerType == MultimeterReduceType_TrimmedMean) {
+            readingCode = MultimeterReduce_trimmedMean(sampleBuffer, sampleCount,
+                                                       MULTIMETER_REDUCE_CODE_BITS + oversamplingBits,
+                                                       reducerParam);
+        }
+        else if (reducerType == MultimeterReduceType_Hampel) {
+            readingCode = MultimeterReduce_hampelMean(sampleBuffer, sampleCount,
+                                                      MULTIMETER_REDUCE_CODE_BITS + oversamplingBits,
+                                                      adcWindowStats.median, reducerParam);
+        }
+    }
+    // samples are no longer needed, drop the result if the driver has
+    // started refilling the buffer under us
+    if (!MultimeterAcq_releaseWindow(&window)) {
+      return true;
+    }
+    Multimeter_commitWindow();
+
+    // size the next windows after the noise of this one, in the AC modes
+    // the variance is the signal itself
+    if (!acMode) {
+        MultimeterAcq_adaptWindow(adcWindowStats.variance);
+    }
+
+    // convert the reference channels scanned ahead of this window
+    if (window.refValid) {
+      for (i = 0; i < MultimeterAcqRef_Count; i++) {
+        VOID MultimeterAcq_codeToMicroVolts(window.refCode[i], 0, &adcRefMicroVolt[i]);
+      }
+    }
+
+    if (acMode) {
+        // follow the DC level with a running mean across windows and take
+        // the RMS of what is left, in code units
+        readingCode = ((acSum << SBP_AC_FRAC_BITS) + sampleCount / 2) / sampleCount;
+        acDcCode = MultimeterReduce_iir(&acDcAccumulator, acDcValid, (int32_t)readingCode,
+                                        SBP_AC_DC_SHIFT);
+        acDcValid = true;
+        readingCode = MultimeterReduce_rms(acSum, acSumSquares, sampleCount,
+                                           (uint32_t)acDcCode, SBP_AC_FRAC_BITS);
+        readingFracBits = oversamplingBits + SBP_AC_FRAC_BITS;
+
+        // the RMS is a code span, only the ADC gain applies to it
+        converted = MultimeterAcq_codeSpanToMicroVolts(readingCode, readingFracBits,
+                                                       &adcValue0MicroVolt);
+    }
+    else {
+        switch (reducerType) {
+            case MultimeterReduceType_TrimmedMean:
+            case MultimeterReduceType_Hampel:
+                // computed ahead of the release
+                readingFracBits = oversamplingBits + MULTIMETER_REDUCE_MEAN_FRAC_BITS;
+                break;
+
+            case MultimeterReduceType_Iir:
+                // exponential average of the window means, a time constant
+                // of 2^reducerParam windows
+                readingCode = ((adcWindowStats.sum << SBP_IIR_FRAC_BITS) + adcWindowStats.count / 2) /
+                              adcWindowStats.count;
+                readingCode = (uint32_t)MultimeterReduce_iir(&iirAccumulator, iirValid,
+                                                             (int32_t)readingCode, reducerParam);
+                iirValid = true;
+                readingFracBits = oversamplingBits + SBP_IIR_FRAC_BITS;
+                break;
+
+            default:
+                if (MultimeterAcq_isMainsSynchronous()) {
+                    // the window spans whole mains cycles, so its mean (unlike
+                    // the median) integrates the line frequency pickup away
+                    readingCode = ((adcWindowStats.sum << SBP_MEAN_FRAC_BITS) + adcWindowStats.count / 2) /
+                                  adcWindowStats.count;
+                    readingFracBits = oversamplingBits + SBP_MEAN_FRAC_BITS;
+                }
+                else {
+                    readingCode = adcWindowStats.median;
+                    readingFracBits = oversamplingBits;
+                }
+                break;
+        }
+
+        // trim and convert the reduced code only
+        converted = MultimeterAcq_codeToMicroVolts(readingCode, readingFracBits,
+                                                   &adcValue0MicroVolt);
+        if (converted && window.refValid) {
+            // remove the residual offset measured on VSS for this window
+            adcValue0MicroVolt = (adcValue0MicroVolt > adcRefMicroVolt[MultimeterAcqRef_Vss]) ?
+                                 adcValue0MicroVolt - adcRefMicroVolt[MultimeterAcqRef_Vss] : 0;
+        }
+
+    }
+
+    // both current modes count charge, the AC mode its DC component
+    if (multimeterMode == MultimeterMode_500mA || multimeterMode == MultimeterMode_500mAAC) {
+        Multimeter_addCharge(&window, acMode ? acSum : adcWindowStats.sum, sampleCount,
+                             oversamplingBits);
+    }
+
+    if (converted && multimeterMode == MultimeterMode_Ohm) {
+        // ratiometric against the latest VDDS measurement
+        uint32_t supplyMicroVolt = Multimeter_getSupplyMicroVolt();
+        uint8_t range = MultimeterOhm_selectRange(ohmRange, adcValue0MicroVolt, supplyMicroVolt);
+
+        // same as the autorange, the reading of the range left is dropped
+        if (range != ohmRange) {
+            Multimeter_setOhmRange(range);
+            return true;
+        }
+        if (!MultimeterOhm_convert(ohmRange, adcValue0MicroVolt, supplyMicroVolt, &adcValue0MicroVolt)) {
+            // open circuit or beyond the top range
+            adcValue0MicroVolt = (unsigned int)-1;
+        }
+        Multimeter_readingReady();
+        return true;
+    }
+
+    // a switch takes effect from the next window, this reading belongs to
+    // the range just left
+    if (converted && multimeterMode == MultimeterMode_AutoV &&
+        Multimeter_autorange(adcValue0MicroVolt)) {
+        return true;
+    }
+
+    if (converted) {
+        //check if overflow (voltage > 3V)
+        if(adcValue0MicroVolt > 3000000)
+        {
+            //set 0xffffffff
+            adcValue0MicroVolt = (unsigned int)-1;
+        }
+        //convert result according to multimeter mode, fixed point only
+        else
+        {
+            adcValue0MicroVolt = (uint32_t)MultimeterScale_apply(Multimeter_getRange(), adcValue0MicroVolt);
+
+            // the latest DC voltage is the load voltage of the energy counter
+            if (multimeterMode == MultimeterMode_3V || multimeterMode == MultimeterMode_10V ||
+                multimeterMode == MultimeterMode_AutoV) {
+                MultimeterCharge_setVoltage((int32_t)adcValue0MicroVolt);
             }
         }
+        Multimeter_readingReady();
+    }
+    else {
+        Display_print0(dispHandle, 0, 0, "ADC channel 0 conversion failed\n");
+    }
+
+    return true;
+}
+
+/*********************************************************************
+ * @fn      Multimeter_commitWindow
+ *
+ * @brief   Count the window processed last in the statistics, the
+ *          histogram and the spectrum. Called once its release showed
+ *          that the driver did not overwrite the samples meanwhile.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+static void Multimeter_commitWindow(void)
+{
+  MultimeterStats_commitWindow();
+  MultimeterSpectrum_commit();
+
+  // the histogram is published whenever one completes
+  if (MultimeterHistogram_commit()) {
+    const uint8_t *pHistogram;
+    uint16_t histogramLen;
+
+    pHistogram = MultimeterHistogram_getPacked(&histogramLen);
+    MultimeterProfile_SetLongParameter(MULTIMETERPROFILE_CHAR12, histogramLen, pHistogram);
+  }
+}
+
+/*********************************************************************
+ * @fn      Multimeter_getRange
+ *
+ * @brief   Range the readings are scaled with, the one selected by the
+ *          autorange mode or else the mode itself.
+ *
+ * @param   None.
+ *
+ * @return  Multimeter range.
+ */
+static MultimeterMode Multimeter_getRange(void)
+{
+  if (multimeterMode == MultimeterMode_AutoV) {
+    return autorangeMode;
+  }
+
+  return (MultimeterMode)multimeterMode;
+}
+
+/*********************************************************************
+ * @fn      Multimeter_autorange
+ *
+ * @brief   Autorange state machine, run on every window. The gap between
+ *          the thresholds keeps a reading close to one of them from
+ *          switching back and forth.
+ *
+ * @param   adcMicroVolt - reading of the window at the ADC input in uV.
+ *
+ * @return  true if the range was switched, false otherwise.
+ */
+static bool Multimeter_autorange(uint32_t adcMicroVolt)
+{
+  if (autorangeMode == MultimeterMode_3V) {
+    if (MultimeterScale_apply(MultimeterMode_3V, adcMicroVolt) > SBP_AUTORANGE_UP_MICROVOLT) {
+      Multimeter_setAutorange(MultimeterMode_10V);
+      return true;
+    }
+  }
+  else if (adcMicroVolt <= 3000000 &&
+           MultimeterScale_apply(MultimeterMode_10V, adcMicroVolt) < SBP_AUTORANGE_DOWN_MICROVOLT) {
+    Multimeter_setAutorange(MultimeterMode_3V);
+    return true;
+  }
+
+  return false;
+}
+
+/*********************************************************************
+ * @fn      Multimeter_setAutorange
+ *
+ * @brief   Switch the autorange mode to a range.
+ *
+ * @param   range - MultimeterMode_3V or MultimeterMode_10V.
+ *
+ * @return  None.
+ */
+static void Multimeter_setAutorange(MultimeterMode range)
+{
+  autorangeMode = range;
+  autorangeSwitchCount++;
+  PIN_setOutputValue(gpioPinHandle, Board_DIO22, (range == MultimeterMode_10V) ? 1 : 0);
+  Multimeter_rangeSwitched();
+
+  Display_print2(dispHandle, 5, 0, "Autorange: %s (%d switches)",
+                 (range == MultimeterMode_10V) ? "10V" : "3V", autorangeSwitchCount);
+}
+
+/*********************************************************************
+ * @fn      Multimeter_setOhmRange
+ *
+ * @brief   Switch the resistance mode to another reference resistor.
+ *
+ * @param   range - resistance range index.
+ *
+ * @return  None.
+ */
+static void Multimeter_setOhmRange(uint8_t range)
+{
+  const multimeterOhmPins_t *pPins = MultimeterOhm_getPins(range);
+
+  ohmRange = range;
+  PIN_setOutputValue(gpioPinHandle, Board_DIO21, pPins->dio21);
+  PIN_setOutputValue(gpioPinHandle, Board_DIO22, pPins->dio22);
+  Multimeter_rangeSwitched();
+
+  Display_print1(dispHandle, 5, 0, "Ohm range: %d", (uint16_t)range);
+}
+
+/*********************************************************************
+ * @fn      Multimeter_rangeSwitched
+ *
+ * @brief   Follow up a range switch made within a mode. The acquisition
+ *          restarts so the next window begins at the switch, and its
+ *          first samples are discarded while the front end settles.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+static void Multimeter_rangeSwitched(void)
+{
+  //code domain state of the old range does not carry over
+  iirValid = false;
+  MultimeterStats_reset();
+  MultimeterHistogram_restart();
+
+  if (!MultimeterAcq_switchRange(PIN_getOutputValue(Board_DIO21),
+                                 PIN_getOutputValue(Board_DIO22))) {
+    Display_print0(dispHandle, 0, 0, "Error initializing ADC channel 0\n");
+    while (1);
+  }
+}
+
+/*********************************************************************
+ * @fn      Multimeter_getSupplyMicroVolt
+ *
+ * @brief   Supply voltage the resistive modes are ratiometric to, the
+ *          latest VDDS measurement of the reference scan. The resistance
+ *          mode always scans, the continuity and diode modes fall back to
+ *          the nominal supply until a scan has run.
+ *
+ * @param   None.
+ *
+ * @return  VDDS in uV.
+ */
+static uint32_t Multimeter_getSupplyMicroVolt(void)
+{
+  return (adcRefMicroVolt[MultimeterAcqRef_Vdds] > 0) ?
+         adcRefMicroVolt[MultimeterAcqRef_Vdds] : SBP_OHM_SUPPLY_MICROVOLT;
+}
+
+/*********************************************************************
+ * @fn      Multimeter_setFastWindow
+ *
+ * @brief   Shorten the window to SBP_CONTINUITY_WINDOW_MS for the
+ *          continuity and diode modes, or restore the settings they
+ *          shortened. The settings are saved as requested, not as in
+ *          effect, so the mains adjusted frequency never replaces the
+ *          requested one and the acquisition is only reconfigured when
+ *          entering or leaving the fast modes.
+ *
+ * @param   fast - true to shorten, false to restore.
+ *
+ * @return  None.
+ */
+static void Multimeter_setFastWindow(bool fast)
+{
+  multimeterAcqConfig_t config;
+
+  if (fast) {
+    if (continuityConfigSaved) {
+      return;
+    }
+    MultimeterAcq_getConfig(&config);
+    continuitySavedConfig = config;
+
+    // the window counts samples at the rate in effect
+    config.windowSize = (uint16_t)(MultimeterAcq_getSamplingFrequency() * SBP_CONTINUITY_WINDOW_MS / 1000);
+    if (config.windowSize == 0) {
+      config.windowSize = 1;
+    }
+    if (config.windowSize >= MultimeterAcq_getWindowSize()) {
+      return;
+    }
+    continuityConfigSaved = true;
+  }
+  else {
+    if (!continuityConfigSaved) {
+      return;
+    }
+    config = continuitySavedConfig;
+    continuityConfigSaved = false;
+  }
+
+  if (!MultimeterAcq_configure(config.samplingFrequency, config.windowSize, config.oversamplingBits,
+                               config.refScan, config.mains)) {
+    Display_print0(dispHandle, 0, 0, "Error restarting ADC channel 0\n");
+  }
+  Multimeter_updateAcqConfigChar();
+}
+
+/*********************************************************************
+ * @fn      Multimeter_setupContinuity
+ *
+ * @brief   Convert the thresholds of the continuity or diode mode to raw
+ *          codes once, so the detector compares raw samples only.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+static void Multimeter_setupContinuity(void)
+{
+  uint32_t supplyMicroVolt = Multimeter_getSupplyMicroVolt();
+  uint32_t closeMicroVolt = SBP_DIODE_CLOSE_MICROVOLT;
+  uint32_t openMicroVolt = SBP_DIODE_OPEN_MICROVOLT;
+  uint16_t closeCode;
+  uint16_t openCode;
+
+  if (multimeterMode == MultimeterMode_Continuity) {
+    // divider voltage of the threshold resistances on the lowest reference
+    closeMicroVolt = (uint32_t)(((uint64_t)supplyMicroVolt * SBP_CONTINUITY_CLOSE_OHM) /
+                                (MULTIMETER_OHM_REF0_OHM + SBP_CONTINUITY_CLOSE_OHM));
+    openMicroVolt = (uint32_t)(((uint64_t)supplyMicroVolt * SBP_CONTINUITY_OPEN_OHM) /
+                               (MULTIMETER_OHM_REF0_OHM + SBP_CONTINUITY_OPEN_OHM));
+  }
+
+  if (!MultimeterAcq_microVoltsToCode(closeMicroVolt, &closeCode) ||
+      !MultimeterAcq_microVoltsToCode(openMicroVolt, &openCode)) {
+    // never closes
+    closeCode = 0;
+    openCode = 0;
+  }
+  MultimeterContinuity_configure(closeCode, openCode);
+
+  continuityEdgePending = false;
+  continuityLatency = 0;
+  continuityMaxLatency = 0;
+}
+
+/*********************************************************************
+ * @fn      Multimeter_addCharge
+ *
+ * @brief   Integrate the mean current of a window in the charge counter,
+ *          by linearity the same as the sum over every raw sample whatever
+ *          the reducer. The mean is held over the time since the previous
+ *          window completed, so the settling samples, the reference scans
+ *          and windows that never reached the task are counted too.
+ *
+ * @param   pWindow - window the samples belong to.
+ * @param   sum - sum of the (decimated) codes of the window.
+ * @param   count - number of (decimated) codes.
+ * @param   oversamplingBits - extra resolution of the codes.
+ *
+ * @return  None.
+ */
+static void Multimeter_addCharge(const multimeterAcqWindow_t *pWindow, uint32_t sum,
+                                 uint16_t count, uint8_t oversamplingBits)
+{
+  uint32_t meanMicroVolt;
+  uint32_t samplingFrequency = MultimeterAcq_getSamplingFrequency();
+  uint32_t microSeconds;
+
+  if (count == 0 ||
+      !MultimeterAcq_codeToMicroVolts(((sum << SBP_MEAN_FRAC_BITS) + count / 2) / count,
+                                      oversamplingBits + SBP_MEAN_FRAC_BITS, &meanMicroVolt)) {
+    // the next window covers this one's time
+    return;
+  }
+  if (pWindow->refValid) {
+    meanMicroVolt = (meanMicroVolt > adcRefMicroVolt[MultimeterAcqRef_Vss]) ?
+                    meanMicroVolt - adcRefMicroVolt[MultimeterAcqRef_Vss] : 0;
+  }
+
+  if (chargeTicksValid) {
+    microSeconds = (pWindow->ticks - chargeTicks) * Clock_tickPeriod;
+  }
+  else if (samplingFrequency > 0) {
+    // the first window after a mode change only has its own samples
+    microSeconds = (uint32_t)(((uint64_t)(pWindow->count + pWindow->discarded) * 1000000) /
+                              samplingFrequency);
+  }
+  else {
+    microSeconds = 0;
+  }
+  chargeTicks = pWindow->ticks;
+  chargeTicksValid = true;
+
+  MultimeterCharge_add(MultimeterScale_apply(MultimeterMode_500mA, meanMicroVolt), microSeconds);
+}
+
+/*********************************************************************
+ * @fn      Multimeter_processContinuity
+ *
+ * @brief   Run the continuity detector on a window. A change is notified
+ *          right away instead of at the next report period, and its
+ *          latency is measured from the first sample that showed it.
+ *
+ * @param   pWindow - window the samples belong to.
+ * @param   samples - raw ADC codes after the settle discard.
+ * @param   count - number of samples.
+ *
+ * @return  None.
+ */
+static void Multimeter_processContinuity(const multimeterAcqWindow_t *pWindow,
+                                         const uint16_t *samples, uint16_t count)
+{
+  multimeterContinuityResult_t result;
+  uint32_t sum = 0;
+  uint32_t microVolt;
+  uint16_t first;
+  uint16_t i;
+  bool notified;
+
+  MultimeterContinuity_process(samples, count, &result);
+  continuityEdgePending |= result.changed;
+
+  // the reading covers the samples since a change, or the whole window
+  first = (result.changed && result.edgeAge < count) ? count - result.edgeAge : 0;
+  for (i = first; i < count; i++) {
+    sum += samples[i];
+  }
+
+  // keep the change pending if the samples were overwritten meanwhile
+  if (!MultimeterAcq_releaseWindow(pWindow)) {
+    return;
+  }
+  Multimeter_commitWindow();
+
+  if (!result.closed) {
+    adcValue0MicroVolt = (unsigned int)-1;
+  }
+  else if (!MultimeterAcq_codeToMicroVolts(((sum << SBP_MEAN_FRAC_BITS) + (count - first) / 2) /
+                                           (count - first),
+                                           SBP_MEAN_FRAC_BITS, &microVolt)) {
+    Display_print0(dispHandle, 0, 0, "ADC channel 0 conversion failed\n");
+    return;
+  }
+  else if (multimeterMode == MultimeterMode_Diode) {
+    adcValue0MicroVolt = microVolt;
+  }
+  else if (!MultimeterOhm_convert(0, microVolt, Multimeter_getSupplyMicroVolt(), &adcValue0MicroVolt)) {
+    adcValue0MicroVolt = (unsigned int)-1;
+  }
+
+  notified = firstReadingPending;
+  Multimeter_readingReady();
+
+  if (continuityEdgePending) {
+    continuityEdgePending = false;
+    if (!notified) {
+      Multimeter_performPeriodicTask();
+    }
+
+    // time from the end of the window to now plus the age of the change
+    // within the window
+    continuityLatency = (Clock_getTicks() - pWindow->ticks) * Clock_tickPeriod +
+                        (uint32_t)(((uint64_t)result.edgeAge * 1000000) /
+                                   MultimeterAcq_getSamplingFrequency());
+    if (continuityLatency > continuityMaxLatency) {
+      continuityMaxLatency = continuityLatency;
+    }
+    Display_print2(dispHandle, 5, 0, "Continuity: %s, %d us",
+                   result.closed ? "closed" : "open", continuityLatency);
+  }
+}
+
+/*********************************************************************
+ * @fn      Multimeter_freqReading
+ *
+ * @brief   Convert a frequency counter result to the reading of the
+ *          current mode. A clean logic level signal is timed by the edge
+ *          capture when it is built in and the signal is fast enough for
+ *          the capture timer.
+ *
+ * @param   pResult - frequency counter result of the ADC stream.
+ *
+ * @return  Frequency in mHz, period in ns or duty cycle in ppm.
+ */
+static uint32_t Multimeter_freqReading(const multimeterFreqResult_t *pResult)
+{
+    const multimeterFreqResult_t *pUsed = pResult;
+#ifdef MULTIMETER_FREQ_TIMER_CAPTURE
+    multimeterFreqResult_t captureResult;
+
+    if (MultimeterFreq_getCapture(&captureResult) && pResult->clean && pResult->cycles > 0 &&
+        pResult->span < (uint64_t)(pResult->timebase / SBP_FREQ_CAPTURE_MAX_PERIOD_DIV) * pResult->cycles) {
+        pUsed = &captureResult;
+    }
+#endif // MULTIMETER_FREQ_TIMER_CAPTURE
+
+    if (pUsed->cycles == 0 || pUsed->span == 0) {
+        // no signal, 0 Hz and an undefined period and duty cycle
+        return (multimeterMode == MultimeterMode_Frequency) ? 0 : (unsigned int)-1;
+    }
+
+    switch (multimeterMode) {
+        case MultimeterMode_Frequency:
+            return (uint32_t)(((uint64_t)pUsed->cycles * pUsed->timebase * 1000) / pUsed->span);
+
+        case MultimeterMode_Period:
+            return (uint32_t)(((uint64_t)pUsed->span * 1000000000) /
+                              ((uint64_t)pUsed->cycles * pUsed->timebase));
+
+        default:
+            return (uint32_t)(((uint64_t)pUsed->high * 1000000) / pUsed->span);
+    }
+}
+
+/*********************************************************************
+ * @fn      Multimeter_readingReady
+ *
+ * @brief   Mark the new reading valid and notify it right away if it is
+ *          the first one after a mode change.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+static void Multimeter_readingReady(void)
+{
+    multimeterAcqSettle_t settle;
+
+    adcValue0Valid = true;
+
+    if (firstReadingPending) {
+        // notify the first reading after a mode change right away and
+        // let the reporting period run from here
+        firstReadingPending = false;
+        Multimeter_performPeriodicTask();
+        Util_startClock(&periodicClock);
+        firstReadingLatency = (Clock_getTicks() - modeChangeTicks) * Clock_tickPeriod / 1000;
+        MultimeterAcq_getSettle(&settle);
+        Display_print2(dispHandle, 4, 0, "First reading: %d ms (switch %d us)",
+                       firstReadingLatency, settle.lastCost);
     }
-    // else return the element in the middle
-    return x[n/2];
 }
 
 /*********************************************************************
  * @fn      Multimeter_performPeriodicTask
  *
  * @brief   Perform a periodic application task. This function gets called
- *          every five seconds (SBP_PERIODIC_EVT_PERIOD). In this example,
- *          the value of the third characteristic in the MultimeterGATTProfile
- *          service is retrieved from the profile, and then copied into the
- *          value of the the fourth characteristic.
+ *          every SBP_PERIODIC_EVT_PERIOD and publishes the latest reduced
+ *          reading in the fourth characteristic of the MultimeterGATTProfile
+ *          service.
  *
  * @param   None.
  *
@@ -1145,49 +2748,66 @@ uint32_t getMedian(int n, uint32_t x[]) {
  */
 static void Multimeter_performPeriodicTask(void)
 {
-    int_fast16_t res;
     int i;
-    res = ADCBuf_convert(adcBuf, &continuousConversion, 1);
-    if (res == ADCBuf_STATUS_SUCCESS) {
-      res = ADCBuf_adjustRawValues(adcBuf, sampleBufferOne, ADC_BUFFER_SIZE, Board_ADCBUFCHANNEL0);
-      if (res == ADCBuf_STATUS_SUCCESS) {
-          res = ADCBuf_convertAdjustedToMicroVolts(adcBuf, Board_ADCBUFCHANNEL0, sampleBufferOne, microVoltBuffer, ADC_BUFFER_SIZE);
-          if (res == ADCBuf_STATUS_SUCCESS) {
-              // get median of data
-              adcValue0MicroVolt = getMedian(ADC_BUFFER_SIZE, microVoltBuffer);
-              //check if overflow (voltage > 3V)
-              if(adcValue0MicroVolt > 3000000)
-              {
-                  //set 0xffffffff
-                  adcValue0MicroVolt = (unsigned int)-1;
-              }
-              //convert result according to multimeter mode
-              else if(multimeterMode == MultimeterMode_10V)
-              {
-                  adcValue0MicroVolt = adcValue0MicroVolt/0.3;
-              }
-              else if(multimeterMode == MultimeterMode_500mA)
-              {
-                  adcValue0MicroVolt = adcValue0MicroVolt/6.85 - 1200;
-              }
-              for (i = 0; i < MULTIMETERPROFILE_CHAR4_LEN ; ++i)
-                  value2copy[i] = ((uint8_t*)&adcValue0MicroVolt)[3-i];
-              MultimeterProfile_SetParameter(MULTIMETERPROFILE_CHAR4, MULTIMETERPROFILE_CHAR4_LEN, value2copy);
-              Display_print1(dispHandle, 0, 0, "ADC channel 0 convert result: %d uV\n", adcValue0MicroVolt);
-          }
-          else {
-              Display_print0(dispHandle, 0, 0, "ADCBuf_convertAdjustedToMicroVolts failed\n");
-          }
-      }
-      else {
-          Display_print0(dispHandle, 0, 0, "ADCBuf_adjustRawValues failed\n");
+
+    Multimeter_updateStatusChar();
+    Multimeter_updateStatsChar();
+    Multimeter_updateSpectrumChar();
+    Multimeter_updateChargeChar();
+
+    if (!adcValue0Valid) {
+      // no window completed yet
+      return;
+    }
+
+    for (i = 0; i < MULTIMETERPROFILE_CHAR4_LEN ; ++i)
+        value2copy[i] = ((uint8_t*)&adcValue0MicroVolt)[3-i];
+    MultimeterProfile_SetParameter(MULTIMETERPROFILE_CHAR4, MULTIMETERPROFILE_CHAR4_LEN, value2copy);
+    Display_print1(dispHandle, 0, 0, "ADC channel 0 convert result: %d uV\n", adcValue0MicroVolt);
+    if (MultimeterAcq_getOversamplingBits() > 0) {
+      Display_print1(dispHandle, 6, 0, "Decimation: %d cyc/output", decimationCyclesPerOutput);
+    }
+    if (multimeterMode == MultimeterMode_10VAC || multimeterMode == MultimeterMode_500mAAC) {
+      Display_print1(dispHandle, 9, 0, "True RMS: %d cyc/sample", rmsCyclesPerSample);
+    }
+    if (MultimeterSpectrum_getBins(NULL) > 0) {
+      Display_print1(dispHandle, 10, 0, "Spectrum: %d cyc/window", spectrumCyclesPerWindow);
+    }
+    {
+      multimeterHistogramConfig_t histogramConfig;
+
+      MultimeterHistogram_getConfig(&histogramConfig);
+      if (histogramConfig.windows > 0) {
+        Display_print1(dispHandle, 11, 0, "Histogram: %d cyc/sample", histogramCyclesPerSample);
       }
     }
-    else {
-      Display_print0(dispHandle, 0, 0, "ADC channel 0 convert failed\n");
+    if (MultimeterAcq_getRefScan()) {
+      Display_print3(dispHandle, 7, 0, "VSS %d uV, DCOUPL %d uV, VDDS %d uV",
+                     adcRefMicroVolt[MultimeterAcqRef_Vss],
+                     adcRefMicroVolt[MultimeterAcqRef_Dcoupl],
+                     adcRefMicroVolt[MultimeterAcqRef_Vdds]);
     }
 }
 
+/*********************************************************************
+ * @fn      Multimeter_adcWindowCB
+ *
+ * @brief   Callback from the acquisition engine indicating that a window
+ *          has been completed. Called from driver context.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+static void Multimeter_adcWindowCB(void)
+{
+  // Store the event.
+  events |= SBP_ADC_WINDOW_EVT;
+
+  // Wake up the application.
+  Semaphore_post(sem);
+}
+
 /*********************************************************************
  * @fn      Multimeter_clockHandler
  *
@@ -1199,6 +2819,16 @@ static void Multimeter_performPeriodicTask(void)
  */
 static void Multimeter_clockHandler(UArg arg)
 {
+  if (arg == SBP_PERIODIC_EVT)
+  {
+    // A report that is still pending has missed its deadline
+    if (events & SBP_PERIODIC_EVT)
+    {
+      reportOverrunCount++;
+    }
+    reportSequence++;
+  }
+
   // Store the event.
   events |= arg;
 
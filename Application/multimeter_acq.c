@@ -0,0 +1,1323 @@
+/******************************************************************************
+
+ @file  multimeter_acq.c
+
+ @brief This file contains the Multimeter ADC acquisition engine. The ADC runs in
+        continuous (recurrence) callback mode and alternates between two
+        sample buffers, so one buffer fills while the application task
+        reduces the other. With the reference scan enabled, the driver is
+        run in one-shot callback mode instead and every measurement window
+        is preceded by short conversions of the VSS, DCOUPL and VDDS
+        channels, chained from the completion callback.
+
+ Group: WCS, BTS
+ Target Device: CC1350
+
+ ******************************************************************************
+
+ Copyright (c) 2013-2017, Texas Instruments Incorporated
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+
+ *  Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+ *  Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+ *  Neither the name of Texas Instruments Incorporated nor the names of
+    its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ Release Name: ti-ble-2.3.2-stack-sdk_1_50_xx
+ Release Date: 2017-09-27 14:52:16
+ *****************************************************************************/
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include <ti/sysbios/knl/Clock.h>
+
+#include "board.h"
+
+#include "multimeter_acq.h"
+#include "multimeter_reduce.h"
+#include "multimeter_ring.h"
+
+/*********************************************************************
+ * CONSTANTS
+ */
+
+// Number of measurement (ping-pong) buffers
+#define ACQ_NUM_BUFFERS                       MULTIMETER_RING_NUM_BUFFERS
+
+// Scan slot of the measurement channel, follows the reference slots
+#define ACQ_SLOT_MEASUREMENT                  MultimeterAcqRef_Count
+
+// Goertzel coefficients 2*cos(2*pi*f/600 Hz) of the mains detection
+#define ACQ_MAINS_COEFF_50HZ                  28378
+#define ACQ_MAINS_COEFF_60HZ                  26510
+
+/*********************************************************************
+ * LOCAL VARIABLES
+ */
+
+static ADCBuf_Handle     adcBuf = NULL;
+static ADCBuf_Params     adcBufParams;
+static ADCBuf_Conversion continuousConversion;
+static ADCBuf_Conversion scanConversion;
+
+// Ping-pong sample buffers, filled alternately by the driver
+static uint16_t sampleBufferOne[MULTIMETER_ACQ_MAX_WINDOW_SIZE];
+static uint16_t sampleBufferTwo[MULTIMETER_ACQ_MAX_WINDOW_SIZE];
+static uint16_t *const acqBuffers[ACQ_NUM_BUFFERS] = { sampleBufferOne, sampleBufferTwo };
+
+// Reference scan buffer and the mean reference codes of each window
+static uint16_t refBuffer[MULTIMETER_ACQ_REF_SAMPLES];
+static uint16_t acqRefCodes[ACQ_NUM_BUFFERS][MultimeterAcqRef_Count];
+
+// ADCBuf channel of each reference slot
+static const uint8_t acqRefChannels[MultimeterAcqRef_Count] =
+{
+  CC1350_LAUNCHXL_ADCBUF0CHANNELVSS,
+  CC1350_LAUNCHXL_ADCBUF0CHANNELDCOUPL,
+  CC1350_LAUNCHXL_ADCBUF0CHANNELVDDS
+};
+
+// Conversions are running, completions are ignored once cleared
+static volatile bool acqRunning = false;
+
+// Settings as requested, before mains synchronisation
+static uint32_t acqRequestedFrequency = MULTIMETER_ACQ_DEFAULT_FREQUENCY;
+static uint16_t acqRequestedWindowSize = MULTIMETER_ACQ_DEFAULT_WINDOW_SIZE;
+static uint8_t acqRequestedOversamplingBits = 0;
+static bool acqRequestedRefScan = false;
+
+// The application needs the reference channels whatever the setting
+static bool acqRefScanRequired = false;
+
+// Mains synchronisation setting, the frequency in use (0 if none) and the
+// samples per mains cycle every window is a multiple of (0 if free-running)
+static MultimeterAcqMains acqMains = MultimeterAcqMains_Off;
+static uint8_t acqMainsFrequency = 0;
+static uint16_t acqCycleSamples = 0;
+
+// Configured window size, the upper bound of the adaptive window
+static uint16_t acqWindowSize = MULTIMETER_ACQ_DEFAULT_WINDOW_SIZE;
+
+// Adaptive window lower bound and target noise in uV, 0 for a fixed window
+static uint16_t acqMinWindowSize = MULTIMETER_ACQ_DEFAULT_WINDOW_SIZE;
+static uint32_t acqNoiseMicroVolt = 0;
+
+// Voltage step of one 12-bit code in uV, measured on first use
+static uint32_t acqLsbMicroVolt = 0;
+
+// Extra bits of resolution gained by oversampling
+static uint8_t acqOversamplingBits = 0;
+
+// Reference scan state, the scan runs when requested or required
+static bool acqRefScan = false;
+static uint8_t acqScanSlot;
+static uint8_t acqFillBuffer;
+
+static multimeterAcqWindowCB_t acqWindowCB = NULL;
+
+// Settle time of each level of the range switches, DIO22 * 2 + DIO21
+static const uint16_t acqSettleTimes[4] =
+{
+  MULTIMETER_ACQ_SETTLE_US_0,
+  MULTIMETER_ACQ_SETTLE_US_1,
+  MULTIMETER_ACQ_SETTLE_US_2,
+  MULTIMETER_ACQ_SETTLE_US_3
+};
+
+// Range switch levels last set (0xFF until the first switch), samples
+// still to discard, and the clock tick of a switch whose first clean
+// window is pending (consumer side only)
+static uint8_t acqSwitchLevels = 0xFF;
+static uint32_t acqSettleSamples = 0;
+static bool acqSwitchPending = false;
+static uint32_t acqSwitchTicks = 0;
+static multimeterAcqSettle_t acqSettle = { 0 };
+
+/*********************************************************************
+ * LOCAL FUNCTIONS
+ */
+static void MultimeterAcq_adcBufCallback(ADCBuf_Handle handle,
+                                         ADCBuf_Conversion *conversion,
+                                         void *completedADCBuffer,
+                                         uint32_t completedChannel);
+static bool MultimeterAcq_open(void);
+static bool MultimeterAcq_startScanSlot(void);
+static void MultimeterAcq_windowDone(uint8_t buffer);
+static uint16_t MultimeterAcq_clampWindowSize(uint16_t windowSize);
+static bool MultimeterAcq_resize(uint16_t windowSize);
+static void MultimeterAcq_applyTiming(void);
+static void MultimeterAcq_retime(void);
+
+/*********************************************************************
+ * PUBLIC FUNCTIONS
+ */
+
+/*********************************************************************
+ * @fn      MultimeterAcq_init
+ *
+ * @brief   Initializes the ADCBuf driver and the conversion descriptors
+ *          and opens the ADC. Opening does not start the sampling timer or
+ *          hold any power constraint, so the idle ADC costs no energy.
+ *
+ * @param   pfnWindowReady - window completion callback.
+ *
+ * @return  None.
+ */
+void MultimeterAcq_init(multimeterAcqWindowCB_t pfnWindowReady)
+{
+  acqWindowCB = pfnWindowReady;
+
+  ADCBuf_init();
+  ADCBuf_Params_init(&adcBufParams);
+  adcBufParams.returnMode = ADCBuf_RETURN_MODE_CALLBACK;
+  adcBufParams.recurrenceMode = ADCBuf_RECURRENCE_MODE_CONTINUOUS;
+  adcBufParams.callbackFxn = MultimeterAcq_adcBufCallback;
+  adcBufParams.samplingFrequency = MULTIMETER_ACQ_DEFAULT_FREQUENCY;
+
+  /* Configure the conversion struct */
+  continuousConversion.arg = NULL;
+  continuousConversion.adcChannel = Board_ADCBUFCHANNEL0;
+  continuousConversion.sampleBuffer = sampleBufferOne;
+  continuousConversion.sampleBufferTwo = sampleBufferTwo;
+  continuousConversion.samplesRequestedCount = MULTIMETER_ACQ_DEFAULT_WINDOW_SIZE;
+
+  /* The scan conversion is rewritten for every slot */
+  scanConversion.arg = NULL;
+  scanConversion.sampleBufferTwo = NULL;
+
+  // Warm standby, a failure is retried by MultimeterAcq_start
+  (void)MultimeterAcq_open();
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_start
+ *
+ * @brief   Starts (or restarts) acquisition, the first window begins now.
+ *
+ * @param   None.
+ *
+ * @return  true on success, false otherwise.
+ */
+bool MultimeterAcq_start(void)
+{
+  bool started;
+
+  // Drop the window in flight, it started before the caller's change
+  MultimeterAcq_standby();
+
+  if (!MultimeterAcq_open())
+  {
+    return (false);
+  }
+
+  acqRunning = true;
+
+  if (acqRefScan)
+  {
+    acqScanSlot = 0;
+    acqFillBuffer = 0;
+    started = MultimeterAcq_startScanSlot();
+  }
+  else
+  {
+    started = (ADCBuf_convert(adcBuf, &continuousConversion, 1) == ADCBuf_STATUS_SUCCESS);
+  }
+
+  if (!started)
+  {
+    acqRunning = false;
+    return (false);
+  }
+
+  return (true);
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_switchRange
+ *
+ * @brief   Restarts the acquisition after a range switch. Samples are
+ *          discarded for the settle time of the new switch levels,
+ *          rounded up to whole mains cycles on synchronised windows, so
+ *          the first window handed out is clean. A switch that leaves
+ *          the levels unchanged settles nothing more.
+ *
+ * @param   dio21 - level of the DIO21 range switch.
+ * @param   dio22 - level of the DIO22 range switch.
+ *
+ * @return  true on success, false otherwise.
+ */
+bool MultimeterAcq_switchRange(uint8_t dio21, uint8_t dio22)
+{
+  uint8_t levels = ((dio22 ? 1 : 0) << 1) | (dio21 ? 1 : 0);
+
+  if (levels != acqSwitchLevels)
+  {
+    acqSwitchLevels = levels;
+    acqSettle.switchCount++;
+
+    acqSettleSamples = (uint32_t)(((uint64_t)acqSettleTimes[levels] *
+                                   adcBufParams.samplingFrequency + 999999) / 1000000);
+    if (acqCycleSamples > 0)
+    {
+      acqSettleSamples = ((acqSettleSamples + acqCycleSamples - 1) / acqCycleSamples) *
+                         acqCycleSamples;
+    }
+  }
+
+  acqSwitchPending = true;
+  acqSwitchTicks = Clock_getTicks();
+
+  return (MultimeterAcq_start());
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_setSwitchLevels
+ *
+ * @brief   Records the levels the range switches were set to while the
+ *          acquisition was in standby, so the next switch settles from
+ *          them rather than from the levels before the standby.
+ *
+ * @param   dio21 - level of the DIO21 range switch.
+ * @param   dio22 - level of the DIO22 range switch.
+ *
+ * @return  None.
+ */
+void MultimeterAcq_setSwitchLevels(uint8_t dio21, uint8_t dio22)
+{
+  acqSwitchLevels = ((dio22 ? 1 : 0) << 1) | (dio21 ? 1 : 0);
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_getSettle
+ *
+ * @brief   Returns the cost of the range switches.
+ *
+ * @param   pSettle - output.
+ *
+ * @return  None.
+ */
+void MultimeterAcq_getSettle(multimeterAcqSettle_t *pSettle)
+{
+  *pSettle = acqSettle;
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_standby
+ *
+ * @brief   Cancels the running acquisition, the ADC stays open.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+void MultimeterAcq_standby(void)
+{
+  if (acqRunning)
+  {
+    // Ignore the completion reported for the cancelled conversion
+    acqRunning = false;
+    ADCBuf_convertCancel(adcBuf);
+  }
+
+  // The producer is stopped, drop the queued windows
+  MultimeterRing_flush();
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_stop
+ *
+ * @brief   Cancels the running acquisition and closes the ADC.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+void MultimeterAcq_stop(void)
+{
+  MultimeterAcq_standby();
+
+  if (adcBuf != NULL)
+  {
+    ADCBuf_close(adcBuf);
+    adcBuf = NULL;
+  }
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_configure
+ *
+ * @brief   Sets the sampling frequency, the window length, the
+ *          oversampling, the reference scan and the mains
+ *          synchronisation. The sampling frequency and the recurrence mode
+ *          are open parameters of the driver, the ADC is only closed and
+ *          reopened when one of them changes. Otherwise it stays open and
+ *          a running acquisition is simply rearmed.
+ *
+ * @param   samplingFrequency - ADC sampling frequency in Hz.
+ * @param   windowSize - raw samples per window.
+ * @param   oversamplingBits - extra bits gained by oversampling.
+ * @param   refScan - scan the reference channels ahead of every window.
+ * @param   mains - mains synchronisation setting, Auto keeps a mains
+ *          frequency it already detected.
+ *
+ * @return  true on success, false otherwise.
+ */
+bool MultimeterAcq_configure(uint32_t samplingFrequency, uint16_t windowSize,
+                             uint8_t oversamplingBits, bool refScan,
+                             MultimeterAcqMains mains)
+{
+  bool running = acqRunning;
+
+  if (samplingFrequency < MULTIMETER_ACQ_MIN_FREQUENCY)
+  {
+    samplingFrequency = MULTIMETER_ACQ_MIN_FREQUENCY;
+  }
+  else if (samplingFrequency > MULTIMETER_ACQ_MAX_FREQUENCY)
+  {
+    samplingFrequency = MULTIMETER_ACQ_MAX_FREQUENCY;
+  }
+
+  if (oversamplingBits > MULTIMETER_ACQ_MAX_OVERSAMPLING)
+  {
+    oversamplingBits = MULTIMETER_ACQ_MAX_OVERSAMPLING;
+  }
+
+  if (mains >= MultimeterAcqMains_Count)
+  {
+    mains = MultimeterAcqMains_Off;
+  }
+
+  acqRequestedFrequency = samplingFrequency;
+  acqRequestedWindowSize = windowSize;
+  acqRequestedOversamplingBits = oversamplingBits;
+  acqRequestedRefScan = refScan;
+
+  // The mains frequency does not change under a repeated Auto setting
+  if (mains != MultimeterAcqMains_Auto || acqMains != MultimeterAcqMains_Auto)
+  {
+    acqMainsFrequency = (mains == MultimeterAcqMains_50Hz) ? 50 :
+                        (mains == MultimeterAcqMains_60Hz) ? 60 : 0;
+  }
+  acqMains = mains;
+
+  MultimeterAcq_retime();
+
+  if (running)
+  {
+    return (MultimeterAcq_start());
+  }
+
+  return (MultimeterAcq_open());
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_getConfig
+ *
+ * @brief   Returns the settings as requested, so a caller can change
+ *          one of them and later restore exactly what was configured.
+ *
+ * @param   pConfig - settings output.
+ *
+ * @return  None.
+ */
+void MultimeterAcq_getConfig(multimeterAcqConfig_t *pConfig)
+{
+  pConfig->samplingFrequency = acqRequestedFrequency;
+  pConfig->windowSize = acqRequestedWindowSize;
+  pConfig->oversamplingBits = acqRequestedOversamplingBits;
+  pConfig->refScan = acqRequestedRefScan;
+  pConfig->mains = acqMains;
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_requireRefScan
+ *
+ * @brief   Makes the reference scan run whatever the configuration, for
+ *          a mode that needs the reference channels in every window. The
+ *          configured setting is kept and applies again once the scan is
+ *          no longer required.
+ *
+ * @param   required - the reference channels are required.
+ *
+ * @return  true on success, false if a running acquisition could not be
+ *          restarted.
+ */
+bool MultimeterAcq_requireRefScan(bool required)
+{
+  bool running = acqRunning;
+
+  if (required == acqRefScanRequired)
+  {
+    return (true);
+  }
+  acqRefScanRequired = required;
+
+  MultimeterAcq_retime();
+
+  if (running)
+  {
+    return (MultimeterAcq_start());
+  }
+
+  return (MultimeterAcq_open());
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_getMains
+ *
+ * @brief   Returns the mains synchronisation setting.
+ *
+ * @param   None.
+ *
+ * @return  Mains synchronisation setting.
+ */
+MultimeterAcqMains MultimeterAcq_getMains(void)
+{
+  return (acqMains);
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_getMainsFrequency
+ *
+ * @brief   Returns the mains frequency the windows are synchronised to.
+ *
+ * @param   None.
+ *
+ * @return  50 or 60 Hz, 0 if free-running or still detecting.
+ */
+uint8_t MultimeterAcq_getMainsFrequency(void)
+{
+  return (acqMainsFrequency);
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_isMainsSynchronous
+ *
+ * @brief   Returns whether every window spans whole mains cycles.
+ *
+ * @param   None.
+ *
+ * @return  true if mains synchronised or detecting.
+ */
+bool MultimeterAcq_isMainsSynchronous(void)
+{
+  return (acqCycleSamples != 0);
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_isDetectingMains
+ *
+ * @brief   Returns whether the mains frequency still has to be detected.
+ *
+ * @param   None.
+ *
+ * @return  true while detecting.
+ */
+bool MultimeterAcq_isDetectingMains(void)
+{
+  return ((acqMains == MultimeterAcqMains_Auto) && (acqMainsFrequency == 0));
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_detectMains
+ *
+ * @brief   Compares the 50 Hz and 60 Hz content of a detection window and
+ *          switches to windows synchronised to the stronger one. The
+ *          detection window spans whole cycles of both, so the choice is
+ *          free of leakage between the two.
+ *
+ * @param   samples - raw ADC codes of a detection window.
+ * @param   count - number of samples.
+ *
+ * @return  true if acquisition was restarted.
+ */
+bool MultimeterAcq_detectMains(const uint16_t *samples, uint16_t count)
+{
+  uint64_t power50;
+  uint64_t power60;
+
+  if (!MultimeterAcq_isDetectingMains())
+  {
+    return (false);
+  }
+
+  power50 = MultimeterReduce_tonePower(samples, count, ACQ_MAINS_COEFF_50HZ);
+  power60 = MultimeterReduce_tonePower(samples, count, ACQ_MAINS_COEFF_60HZ);
+
+  acqMainsFrequency = (power60 > power50) ? 60 : 50;
+
+  // The sampling frequency is an open parameter, reopen the ADC if it moved
+  MultimeterAcq_retime();
+  (void)MultimeterAcq_start();
+
+  return (true);
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_setAdaptiveWindow
+ *
+ * @brief   Sets the bounds and the target noise of the adaptive window.
+ *          The configured window size is the upper bound.
+ *
+ * @param   minWindowSize - lower bound of the window size.
+ * @param   noiseMicroVolt - target noise of a reading in uV, 0 to keep the
+ *                           window fixed at its configured size.
+ *
+ * @return  true on success, false otherwise.
+ */
+bool MultimeterAcq_setAdaptiveWindow(uint16_t minWindowSize, uint32_t noiseMicroVolt)
+{
+  acqMinWindowSize = MultimeterAcq_clampWindowSize(minWindowSize);
+  if (acqMinWindowSize > acqWindowSize)
+  {
+    acqMinWindowSize = acqWindowSize;
+  }
+
+  acqNoiseMicroVolt = (noiseMicroVolt > MULTIMETER_ACQ_MAX_NOISE) ?
+                      MULTIMETER_ACQ_MAX_NOISE : noiseMicroVolt;
+
+  // Start from the upper bound, the first windows shrink it as needed
+  return (MultimeterAcq_resize(acqWindowSize));
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_adaptWindow
+ *
+ * @brief   Sizes the next windows so that the median of a window reaches
+ *          the target noise. For N samples of variance s^2 the median
+ *          varies by about (pi/2) * s^2 / N, so the window needs
+ *          N = (pi/2) * s^2 * lsb^2 / noise^2 raw samples. Decimation
+ *          cancels out: it divides the variance and the number of outputs
+ *          by the same ratio. The window grows as soon as it is too short
+ *          and only shrinks once half of it would do, so it does not
+ *          toggle between two sizes.
+ *
+ * @param   variance - sample variance of the reduced codes, in squared
+ *                     codes with the oversampling bits as fraction.
+ *
+ * @return  None.
+ */
+void MultimeterAcq_adaptWindow(uint32_t variance)
+{
+  uint16_t windowSize = (uint16_t)continuousConversion.samplesRequestedCount;
+  uint32_t fullScale;
+  uint64_t required;
+
+  if ((acqNoiseMicroVolt == 0) || MultimeterAcq_isDetectingMains())
+  {
+    return;
+  }
+
+  if (acqLsbMicroVolt == 0)
+  {
+    if (!MultimeterAcq_codeToMicroVolts(0xFFF, 0, &fullScale))
+    {
+      return;
+    }
+    acqLsbMicroVolt = (fullScale + 0x7FF) / 0xFFF;
+  }
+
+  // pi/2 approximated by 8/5
+  required = ((uint64_t)variance * acqLsbMicroVolt * acqLsbMicroVolt * 8) /
+             ((uint64_t)acqNoiseMicroVolt * acqNoiseMicroVolt * 5) + 1;
+
+  // Keep whole mains cycles
+  if (acqCycleSamples != 0)
+  {
+    required = (required + acqCycleSamples - 1) / acqCycleSamples * acqCycleSamples;
+  }
+
+  if (required > acqWindowSize)
+  {
+    required = acqWindowSize;
+  }
+  else if (required < acqMinWindowSize)
+  {
+    required = acqMinWindowSize;
+  }
+
+  if ((required > windowSize) || (required <= windowSize / 2))
+  {
+    (void)MultimeterAcq_resize((uint16_t)required);
+  }
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_getMinWindowSize
+ *
+ * @brief   Returns the lower bound of the adaptive window.
+ *
+ * @param   None.
+ *
+ * @return  Smallest number of samples per window.
+ */
+uint16_t MultimeterAcq_getMinWindowSize(void)
+{
+  return (acqMinWindowSize);
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_getNoiseTarget
+ *
+ * @brief   Returns the target noise of the adaptive window.
+ *
+ * @param   None.
+ *
+ * @return  Target noise in uV, 0 for a fixed window.
+ */
+uint32_t MultimeterAcq_getNoiseTarget(void)
+{
+  return (acqNoiseMicroVolt);
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_getCurrentWindowSize
+ *
+ * @brief   Returns the size of the window being acquired.
+ *
+ * @param   None.
+ *
+ * @return  Samples per window.
+ */
+uint16_t MultimeterAcq_getCurrentWindowSize(void)
+{
+  return ((uint16_t)continuousConversion.samplesRequestedCount);
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_getRefScan
+ *
+ * @brief   Returns whether the reference scan is enabled by the
+ *          configuration. The scan also runs while required, see
+ *          MultimeterAcq_requireRefScan.
+ *
+ * @param   None.
+ *
+ * @return  true if the configuration scans the reference channels.
+ */
+bool MultimeterAcq_getRefScan(void)
+{
+  return (acqRequestedRefScan);
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_getSamplingFrequency
+ *
+ * @brief   Returns the sampling frequency.
+ *
+ * @param   None.
+ *
+ * @return  Sampling frequency in Hz.
+ */
+uint32_t MultimeterAcq_getSamplingFrequency(void)
+{
+  return (adcBufParams.samplingFrequency);
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_getWindowSize
+ *
+ * @brief   Returns the configured number of samples per window.
+ *
+ * @param   None.
+ *
+ * @return  Samples per window.
+ */
+uint16_t MultimeterAcq_getWindowSize(void)
+{
+  return (acqWindowSize);
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_getOversamplingBits
+ *
+ * @brief   Returns the number of oversampling bits.
+ *
+ * @param   None.
+ *
+ * @return  Oversampling bits, the oversampling ratio is 4^bits.
+ */
+uint8_t MultimeterAcq_getOversamplingBits(void)
+{
+  return (acqOversamplingBits);
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_getWindow
+ *
+ * @brief   Takes the oldest queued window descriptor (consumer side of the
+ *          ring). Only the descriptor is copied, the samples are read in
+ *          place. Windows whose buffer the driver has already started
+ *          refilling are skipped and counted as overruns. After a range
+ *          switch the settling samples are cut off the front of the
+ *          window in whole oversampling groups, so the rest decimates to
+ *          whole outputs. Windows left with less than one group are
+ *          skipped.
+ *
+ * @param   pWindow - completed window output.
+ *
+ * @return  true if a window was ready, false otherwise.
+ */
+bool MultimeterAcq_getWindow(multimeterAcqWindow_t *pWindow)
+{
+  uint32_t ratio = 1UL << (2 * acqOversamplingBits);
+  uint32_t cut;
+
+  while (MultimeterRing_get(pWindow))
+  {
+    if (acqSettleSamples > 0)
+    {
+      cut = ((acqSettleSamples + ratio - 1) / ratio) * ratio;
+      if (cut + ratio > pWindow->count)
+      {
+        // Settling throughout, or too little left for one output
+        acqSettleSamples = (acqSettleSamples > pWindow->count) ?
+                           acqSettleSamples - pWindow->count : 0;
+        acqSettle.discardedSamples += pWindow->count;
+        continue;
+      }
+
+      pWindow->samples += cut;
+      pWindow->count -= (uint16_t)cut;
+      pWindow->discarded = (uint16_t)cut;
+      acqSettle.discardedSamples += cut;
+      acqSettleSamples = 0;
+    }
+
+    if (acqSwitchPending)
+    {
+      acqSwitchPending = false;
+      acqSettle.lastCost = (pWindow->ticks - acqSwitchTicks) * Clock_tickPeriod;
+      if (acqSettle.lastCost > acqSettle.maxCost)
+      {
+        acqSettle.maxCost = acqSettle.lastCost;
+      }
+    }
+
+    return (true);
+  }
+
+  return (false);
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_releaseWindow
+ *
+ * @brief   Ends the use of the samples of a window. The driver never waits
+ *          for the application, so this only checks that the buffer was
+ *          not refilled while the samples were being read.
+ *
+ * @param   pWindow - window taken by MultimeterAcq_getWindow.
+ *
+ * @return  true if the samples were intact, false otherwise.
+ */
+bool MultimeterAcq_releaseWindow(const multimeterAcqWindow_t *pWindow)
+{
+  return (MultimeterRing_release(pWindow));
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_getHandle
+ *
+ * @brief   Returns the ADCBuf handle of the running acquisition.
+ *
+ * @param   None.
+ *
+ * @return  ADCBuf handle, NULL while closed.
+ */
+ADCBuf_Handle MultimeterAcq_getHandle(void)
+{
+  return (adcBuf);
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_isRunning
+ *
+ * @brief   Returns whether conversions are running.
+ *
+ * @param   None.
+ *
+ * @return  true while running, false in standby or while closed.
+ */
+bool MultimeterAcq_isRunning(void)
+{
+  return (acqRunning);
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_codeToMicroVolts
+ *
+ * @brief   Trims and converts a single raw code. Both steps are monotonic,
+ *          so reductions such as the median can be taken on raw codes and
+ *          only the result needs to be converted. Codes with fractional
+ *          bits are linearly interpolated between the two neighbouring
+ *          12-bit codes.
+ *
+ * @param   code - raw ADC code with fracBits fractional bits.
+ * @param   fracBits - number of fractional bits.
+ * @param   pMicroVolt - converted voltage output.
+ *
+ * @return  true on success, false otherwise.
+ */
+bool MultimeterAcq_codeToMicroVolts(uint32_t code, uint8_t fracBits,
+                                    uint32_t *pMicroVolt)
+{
+  uint16_t codes[2];
+  uint32_t microVolts[2];
+  uint32_t frac = code & ((1UL << fracBits) - 1);
+
+  if (adcBuf == NULL)
+  {
+    return (false);
+  }
+
+  codes[0] = (uint16_t)(code >> fracBits);
+  codes[1] = (codes[0] < 0xFFF) ? codes[0] + 1 : codes[0];
+
+  if (ADCBuf_adjustRawValues(adcBuf, codes, 2,
+                             continuousConversion.adcChannel) != ADCBuf_STATUS_SUCCESS)
+  {
+    return (false);
+  }
+
+  if (ADCBuf_convertAdjustedToMicroVolts(adcBuf, continuousConversion.adcChannel,
+                                         codes, microVolts, 2) != ADCBuf_STATUS_SUCCESS)
+  {
+    return (false);
+  }
+
+  *pMicroVolt = microVolts[0] +
+                (((microVolts[1] - microVolts[0]) * frac) >> fracBits);
+
+  return (true);
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_codeSpanToMicroVolts
+ *
+ * @brief   Converts a code difference through the same trim as single
+ *          codes, minus the voltage of code 0, so only the gain applies.
+ *
+ * @param   span - code difference with fracBits fractional bits.
+ * @param   fracBits - number of fractional bits.
+ * @param   pMicroVolt - converted voltage output.
+ *
+ * @return  true on success, false otherwise.
+ */
+bool MultimeterAcq_codeSpanToMicroVolts(uint32_t span, uint8_t fracBits,
+                                        uint32_t *pMicroVolt)
+{
+  uint32_t zeroMicroVolt;
+  uint32_t spanMicroVolt;
+
+  if (!MultimeterAcq_codeToMicroVolts(0, 0, &zeroMicroVolt) ||
+      !MultimeterAcq_codeToMicroVolts(span, fracBits, &spanMicroVolt))
+  {
+    return (false);
+  }
+
+  *pMicroVolt = (spanMicroVolt > zeroMicroVolt) ? spanMicroVolt - zeroMicroVolt : 0;
+
+  return (true);
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_microVoltsToCode
+ *
+ * @brief   Inverts the conversion of single codes by a binary search over
+ *          the 12-bit codes, it is monotonic. Meant for thresholds set up
+ *          once, not for every sample.
+ *
+ * @param   microVolt - voltage at the ADC input.
+ * @param   pCode - raw code output.
+ *
+ * @return  true on success, false otherwise.
+ */
+bool MultimeterAcq_microVoltsToCode(uint32_t microVolt, uint16_t *pCode)
+{
+  uint16_t low = 0;
+  uint16_t high = 0xFFF;
+  uint16_t mid;
+  uint32_t midMicroVolt;
+
+  while (low < high)
+  {
+    mid = (low + high) / 2;
+    if (!MultimeterAcq_codeToMicroVolts(mid, 0, &midMicroVolt))
+    {
+      return (false);
+    }
+
+    if (midMicroVolt < microVolt)
+    {
+      low = mid + 1;
+    }
+    else
+    {
+      high = mid;
+    }
+  }
+
+  *pCode = low;
+
+  return (true);
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_getOverrunCount
+ *
+ * @brief   Returns the number of lost or overwritten windows.
+ *
+ * @param   None.
+ *
+ * @return  Overrun count.
+ */
+uint32_t MultimeterAcq_getOverrunCount(void)
+{
+  return (MultimeterRing_getOverrunCount());
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_getOverflowCount
+ *
+ * @brief   Returns the number of windows dropped on a full ring.
+ *
+ * @param   None.
+ *
+ * @return  Overflow count.
+ */
+uint32_t MultimeterAcq_getOverflowCount(void)
+{
+  return (MultimeterRing_getOverflowCount());
+}
+
+/*********************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+/*********************************************************************
+ * @fn      MultimeterAcq_adcBufCallback
+ *
+ * @brief   ADCBuf completion callback (driver SWI context). In continuous
+ *          mode the driver has already switched DMA to the other buffer.
+ *          In reference scan mode the next slot of the scan is started
+ *          from here, so the sequence runs without waking the task.
+ *
+ * @param   handle - ADCBuf handle.
+ * @param   conversion - completed conversion.
+ * @param   completedADCBuffer - buffer that has just been filled.
+ * @param   completedChannel - channel that was sampled.
+ *
+ * @return  None.
+ */
+static void MultimeterAcq_adcBufCallback(ADCBuf_Handle handle,
+                                         ADCBuf_Conversion *conversion,
+                                         void *completedADCBuffer,
+                                         uint32_t completedChannel)
+{
+  uint32_t sum;
+  uint8_t i;
+
+  if (!acqRunning)
+  {
+    return;
+  }
+
+  if (!acqRefScan)
+  {
+    MultimeterAcq_windowDone((completedADCBuffer == sampleBufferOne) ? 0 : 1);
+    return;
+  }
+
+  if (acqScanSlot < ACQ_SLOT_MEASUREMENT)
+  {
+    // Reference slot, keep the mean code with the window that follows
+    sum = 0;
+    for (i = 0; i < MULTIMETER_ACQ_REF_SAMPLES; i++)
+    {
+      sum += refBuffer[i];
+    }
+    acqRefCodes[acqFillBuffer][acqScanSlot] =
+      (uint16_t)((sum + MULTIMETER_ACQ_REF_SAMPLES / 2) / MULTIMETER_ACQ_REF_SAMPLES);
+    acqScanSlot++;
+  }
+  else
+  {
+    MultimeterAcq_windowDone(acqFillBuffer);
+    acqFillBuffer ^= 1;
+    acqScanSlot = 0;
+  }
+
+  // A scan that cannot be rearmed loses the window in progress
+  if (!MultimeterAcq_startScanSlot())
+  {
+    MultimeterRing_countLost();
+  }
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_open
+ *
+ * @brief   Opens the ADC with the current parameters if it is closed.
+ *
+ * @param   None.
+ *
+ * @return  true if the ADC is open.
+ */
+static bool MultimeterAcq_open(void)
+{
+  if (adcBuf == NULL)
+  {
+    // The reference scan chains one-shot conversions from the callback
+    adcBufParams.recurrenceMode = acqRefScan ? ADCBuf_RECURRENCE_MODE_ONE_SHOT :
+                                               ADCBuf_RECURRENCE_MODE_CONTINUOUS;
+
+    adcBuf = ADCBuf_open(Board_ADCBUF0, &adcBufParams);
+  }
+
+  return (adcBuf != NULL);
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_startScanSlot
+ *
+ * @brief   Starts the one-shot conversion of the current scan slot.
+ *
+ * @param   None.
+ *
+ * @return  true if the conversion was started.
+ */
+static bool MultimeterAcq_startScanSlot(void)
+{
+  if (acqScanSlot < ACQ_SLOT_MEASUREMENT)
+  {
+    scanConversion.adcChannel = acqRefChannels[acqScanSlot];
+    scanConversion.sampleBuffer = refBuffer;
+    scanConversion.samplesRequestedCount = MULTIMETER_ACQ_REF_SAMPLES;
+  }
+  else
+  {
+    scanConversion.adcChannel = continuousConversion.adcChannel;
+    scanConversion.sampleBuffer = acqBuffers[acqFillBuffer];
+    scanConversion.samplesRequestedCount = continuousConversion.samplesRequestedCount;
+  }
+
+  return (ADCBuf_convert(adcBuf, &scanConversion, 1) == ADCBuf_STATUS_SUCCESS);
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_windowDone
+ *
+ * @brief   Queues a completed window for the application. The other
+ *          buffer is about to be refilled, which invalidates any window
+ *          still queued or held in it.
+ *
+ * @param   buffer - index of the completed buffer.
+ *
+ * @return  None.
+ */
+static void MultimeterAcq_windowDone(uint8_t buffer)
+{
+  multimeterAcqWindow_t window;
+  uint8_t i;
+
+  window.samples = acqBuffers[buffer];
+  window.count = (uint16_t)continuousConversion.samplesRequestedCount;
+  window.discarded = 0;
+  window.refValid = acqRefScan;
+  for (i = 0; i < MultimeterAcqRef_Count; i++)
+  {
+    window.refCode[i] = acqRefCodes[buffer][i];
+  }
+  window.buffer = buffer;
+  window.ticks = Clock_getTicks();
+
+  MultimeterRing_put(&window);
+
+  if (acqWindowCB)
+  {
+    acqWindowCB();
+  }
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_clampWindowSize
+ *
+ * @brief   Limits a window size to the buffer size and to at least one
+ *          decimated output. Mains synchronised windows are rounded down
+ *          to whole cycles, at least one.
+ *
+ * @param   windowSize - requested samples per window.
+ *
+ * @return  Supported samples per window.
+ */
+static uint16_t MultimeterAcq_clampWindowSize(uint16_t windowSize)
+{
+  if (windowSize > MULTIMETER_ACQ_MAX_WINDOW_SIZE)
+  {
+    windowSize = MULTIMETER_ACQ_MAX_WINDOW_SIZE;
+  }
+
+  if (acqCycleSamples != 0)
+  {
+    return ((windowSize < acqCycleSamples) ? acqCycleSamples :
+            windowSize - (windowSize % acqCycleSamples));
+  }
+
+  if (windowSize < (1 << (2 * acqOversamplingBits)))
+  {
+    return (1 << (2 * acqOversamplingBits));
+  }
+
+  return (windowSize);
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_resize
+ *
+ * @brief   Changes the size of the following windows. The request count
+ *          is only read when a conversion starts, so a running acquisition
+ *          is restarted; the ADC stays open.
+ *
+ * @param   windowSize - samples per window.
+ *
+ * @return  true on success, false otherwise.
+ */
+static bool MultimeterAcq_resize(uint16_t windowSize)
+{
+  if (windowSize == continuousConversion.samplesRequestedCount)
+  {
+    return (true);
+  }
+
+  continuousConversion.samplesRequestedCount = windowSize;
+
+  if (acqRunning)
+  {
+    return (MultimeterAcq_start());
+  }
+
+  return (true);
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_applyTiming
+ *
+ * @brief   Derives the driver sampling frequency, the oversampling and the
+ *          window sizes from the requested settings. When mains
+ *          synchronised, the samples per mains cycle are a whole number of
+ *          decimated outputs, the sampling frequency is that number times
+ *          the mains frequency and every window is a whole number of
+ *          cycles. Averaging over whole cycles then nulls the line
+ *          frequency and its harmonics at no processing cost. The driver
+ *          only reads its parameters when it opens, see
+ *          MultimeterAcq_retime.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+static void MultimeterAcq_applyTiming(void)
+{
+  uint16_t ratio;
+  uint32_t cycleSamples;
+
+  adcBufParams.samplingFrequency = acqRequestedFrequency;
+  acqOversamplingBits = acqRequestedOversamplingBits;
+  acqRefScan = acqRequestedRefScan || acqRefScanRequired;
+  acqCycleSamples = 0;
+
+  if (MultimeterAcq_isDetectingMains())
+  {
+    // Raw samples at a rate common to both mains frequencies
+    adcBufParams.samplingFrequency = MULTIMETER_ACQ_MAINS_DETECT_FREQUENCY;
+    acqOversamplingBits = 0;
+    acqCycleSamples = MULTIMETER_ACQ_MAINS_DETECT_WINDOW;
+  }
+  else if (acqMainsFrequency != 0)
+  {
+    ratio = 1 << (2 * acqOversamplingBits);
+
+    // Nearest whole number of outputs per cycle to the requested frequency
+    cycleSamples = (acqRequestedFrequency / acqMainsFrequency + ratio / 2) / ratio * ratio;
+    if (cycleSamples < ratio)
+    {
+      cycleSamples = ratio;
+    }
+    while ((cycleSamples > ratio) &&
+           ((cycleSamples > MULTIMETER_ACQ_MAX_WINDOW_SIZE) ||
+            (cycleSamples * acqMainsFrequency > MULTIMETER_ACQ_MAX_FREQUENCY)))
+    {
+      cycleSamples -= ratio;
+    }
+
+    acqCycleSamples = (uint16_t)cycleSamples;
+    adcBufParams.samplingFrequency = cycleSamples * acqMainsFrequency;
+  }
+
+  // An adaptive window restarts from its upper bound
+  acqWindowSize = MultimeterAcq_clampWindowSize(acqRequestedWindowSize);
+  acqMinWindowSize = MultimeterAcq_clampWindowSize(acqMinWindowSize);
+  if (acqMinWindowSize > acqWindowSize)
+  {
+    acqMinWindowSize = acqWindowSize;
+  }
+  continuousConversion.samplesRequestedCount = acqWindowSize;
+}
+
+/*********************************************************************
+ * @fn      MultimeterAcq_retime
+ *
+ * @brief   Applies the requested settings. The acquisition is stopped,
+ *          and the ADC is closed only if the sampling frequency or the
+ *          recurrence mode it was opened with no longer match, so the
+ *          next MultimeterAcq_open reopens it with the new ones. Keeping
+ *          it open saves the driver setup on every reconfiguration that
+ *          only touches the window or the oversampling.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+static void MultimeterAcq_retime(void)
+{
+  uint32_t openFrequency = adcBufParams.samplingFrequency;
+  ADCBuf_Recurrence_Mode openRecurrence = adcBufParams.recurrenceMode;
+
+  MultimeterAcq_standby();
+  MultimeterAcq_applyTiming();
+
+  if ((adcBufParams.samplingFrequency != openFrequency) ||
+      ((acqRefScan ? ADCBuf_RECURRENCE_MODE_ONE_SHOT : ADCBuf_RECURRENCE_MODE_CONTINUOUS) !=
+       openRecurrence))
+  {
+    MultimeterAcq_stop();
+  }
+}
+
+/*********************************************************************
+*********************************************************************/
@@ -0,0 +1,502 @@
+/******************************************************************************
+
+ @file  multimeter_acq.h
+
+ @brief This file contains the Multimeter ADC acquisition engine definitions and
+        prototypes.
+
+ Group: WCS, BTS
+ Target Device: CC1350
+
+ ******************************************************************************
+
+ Copyright (c) 2013-2017, Texas Instruments Incorporated
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+
+ *  Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+ *  Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+ *  Neither the name of Texas Instruments Incorporated nor the names of
+    its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ Release Name: ti-ble-2.3.2-stack-sdk_1_50_xx
+ Release Date: 2017-09-27 14:52:16
+ *****************************************************************************/
+
+#ifndef MULTIMETER_ACQ_H
+#define MULTIMETER_ACQ_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <ti/drivers/ADCBuf.h>
+
+/*********************************************************************
+ * CONSTANTS
+ */
+
+// Largest acquisition window, sizes each of the two ping-pong buffers.
+// The two buffers take 4 bytes per sample of the CC1350's 20 KB SRAM, most
+// of which belongs to the BLE stack, so 1024 samples (4 KB) is the most
+// this build affords. Longer integration comes from the statistics, which
+// accumulate across windows; a build with more free RAM may raise it.
+#ifndef MULTIMETER_ACQ_MAX_WINDOW_SIZE
+#define MULTIMETER_ACQ_MAX_WINDOW_SIZE        1024
+#endif
+
+// Default number of samples in one acquisition window
+#define MULTIMETER_ACQ_DEFAULT_WINDOW_SIZE    100
+
+// Supported ADC sampling frequencies in Hz
+#define MULTIMETER_ACQ_MIN_FREQUENCY          1
+#define MULTIMETER_ACQ_MAX_FREQUENCY          200000
+
+// Default ADC sampling frequency in Hz (100 samples at 1 kHz = 100 ms per window)
+#define MULTIMETER_ACQ_DEFAULT_FREQUENCY      1000
+
+// Largest number of oversampling bits (oversampling ratio 4^4 = 256)
+#define MULTIMETER_ACQ_MAX_OVERSAMPLING       4
+
+// Samples taken on each reference channel ahead of a window when the
+// reference scan is enabled
+#define MULTIMETER_ACQ_REF_SAMPLES            4
+
+// Largest target noise of the adaptive window in uV
+#define MULTIMETER_ACQ_MAX_NOISE              1000000
+
+// Mains detection: 300 samples at 600 Hz span exactly 25 cycles of 50 Hz
+// and 30 cycles of 60 Hz
+#define MULTIMETER_ACQ_MAINS_DETECT_FREQUENCY 600
+#define MULTIMETER_ACQ_MAINS_DETECT_WINDOW    300
+
+// Window descriptors queued between the driver and the application,
+// must be a power of two
+#ifndef MULTIMETER_ACQ_RING_SIZE
+#define MULTIMETER_ACQ_RING_SIZE              4
+#endif
+
+// Front end settle time after the range switches change (in usec), by
+// their new levels DIO22 * 2 + DIO21. The ranges with the highest
+// impedance in front of the ADC (the 10V divider, the large resistance
+// references) take the longest to charge the input capacitance.
+#ifndef MULTIMETER_ACQ_SETTLE_US_0
+#define MULTIMETER_ACQ_SETTLE_US_0            200
+#endif
+#ifndef MULTIMETER_ACQ_SETTLE_US_1
+#define MULTIMETER_ACQ_SETTLE_US_1            500
+#endif
+#ifndef MULTIMETER_ACQ_SETTLE_US_2
+#define MULTIMETER_ACQ_SETTLE_US_2            1000
+#endif
+#ifndef MULTIMETER_ACQ_SETTLE_US_3
+#define MULTIMETER_ACQ_SETTLE_US_3            2000
+#endif
+
+/*********************************************************************
+ * TYPEDEFS
+ */
+
+/*!
+ *  @def    MultimeterAcqRef
+ *  @brief  Enum of reference channels scanned ahead of every window
+ */
+typedef enum MultimeterAcqRef {
+    MultimeterAcqRef_Vss = 0,   // Ground, residual ADC offset
+    MultimeterAcqRef_Dcoupl,    // Internal 1.27 V regulator, ADC gain check
+    MultimeterAcqRef_Vdds,      // Supply voltage
+
+    MultimeterAcqRef_Count
+} MultimeterAcqRef;
+
+/*!
+ *  @def    MultimeterAcqMains
+ *  @brief  Enum of mains synchronisation settings
+ */
+typedef enum MultimeterAcqMains {
+    MultimeterAcqMains_Off = 0, // Free-running sampling frequency and window
+    MultimeterAcqMains_50Hz,    // Windows span whole 50 Hz cycles
+    MultimeterAcqMains_60Hz,    // Windows span whole 60 Hz cycles
+    MultimeterAcqMains_Auto,    // Detect 50 or 60 Hz on the input first
+
+    MultimeterAcqMains_Count
+} MultimeterAcqMains;
+
+// Completed acquisition window. The descriptor is copied, the samples stay
+// in the driver buffer.
+typedef struct
+{
+  uint16_t *samples;                          // Raw codes of the measurement channel
+  uint16_t count;                             // Number of samples
+  uint16_t discarded;                         // Settling samples dropped ahead of them
+  bool     refValid;                          // refCode was scanned for this window
+  uint16_t refCode[MultimeterAcqRef_Count];   // Mean raw code of each reference channel
+  uint8_t  buffer;                            // Driver buffer holding the samples
+  uint32_t generation;                        // Fill count of that buffer, checked on release
+  uint32_t ticks;                             // Clock tick at which the window completed
+} multimeterAcqWindow_t;
+
+// Settings as passed to MultimeterAcq_configure, after clamping
+typedef struct
+{
+  uint32_t samplingFrequency;
+  uint16_t windowSize;
+  uint8_t  oversamplingBits;
+  bool     refScan;
+  MultimeterAcqMains mains;
+} multimeterAcqConfig_t;
+
+// Cost of the range switches
+typedef struct
+{
+  uint32_t switchCount;       // Switches that changed the range switch levels
+  uint32_t discardedSamples;  // Settling samples discarded since init
+  uint32_t lastCost;          // Last switch to the end of its first clean window, in usec
+  uint32_t maxCost;           // Highest cost since init, in usec
+} multimeterAcqSettle_t;
+
+// Callback when a window has been completed, called from driver (SWI) context
+typedef void (*multimeterAcqWindowCB_t)(void);
+
+/*********************************************************************
+ * FUNCTIONS
+ */
+
+/*
+ * MultimeterAcq_init - Initializes the ADCBuf driver and the conversion
+ *                      descriptors and opens the ADC in warm standby.
+ *
+ *    pfnWindowReady - called from driver context every time a window has
+ *                     been completed and is ready to be reduced.
+ */
+extern void MultimeterAcq_init(multimeterAcqWindowCB_t pfnWindowReady);
+
+/*
+ * MultimeterAcq_start - Starts double-buffered acquisition, opening the ADC
+ *                       if needed. A running acquisition is restarted so
+ *                       the next window begins now; windows in flight are
+ *                       dropped.
+ *
+ * @return  true on success, false if the driver could not be started
+ */
+extern bool MultimeterAcq_start(void);
+
+/*
+ * MultimeterAcq_switchRange - Restarts the acquisition after the range
+ *                             switches were set. If their levels changed,
+ *                             the samples taken during the settle time of
+ *                             the new levels are discarded, whole windows
+ *                             included.
+ *
+ *    dio21 - level of the DIO21 range switch
+ *    dio22 - level of the DIO22 range switch
+ *
+ * @return  true on success, false if the driver could not be started
+ */
+extern bool MultimeterAcq_switchRange(uint8_t dio21, uint8_t dio22);
+
+/*
+ * MultimeterAcq_setSwitchLevels - Records the levels the range switches
+ *                                 were set to in standby, without a
+ *                                 restart. The next MultimeterAcq_switchRange
+ *                                 settles if its levels differ from them.
+ *
+ *    dio21 - level of the DIO21 range switch
+ *    dio22 - level of the DIO22 range switch
+ */
+extern void MultimeterAcq_setSwitchLevels(uint8_t dio21, uint8_t dio22);
+
+/*
+ * MultimeterAcq_getSettle - Returns the cost of the range switches.
+ *
+ *    pSettle - output
+ */
+extern void MultimeterAcq_getSettle(multimeterAcqSettle_t *pSettle);
+
+/*
+ * MultimeterAcq_standby - Cancels the running acquisition but keeps the ADC
+ *                         open and configured, so MultimeterAcq_start only
+ *                         has to trigger a conversion.
+ */
+extern void MultimeterAcq_standby(void);
+
+/*
+ * MultimeterAcq_stop - Cancels the running acquisition and closes the ADC.
+ */
+extern void MultimeterAcq_stop(void);
+
+/*
+ * MultimeterAcq_configure - Sets the sampling frequency, the window length,
+ *                           the oversampling, the reference scan and the
+ *                           mains synchronisation. The ADC is only reopened
+ *                           when the sampling frequency or the recurrence
+ *                           mode changes, and a running acquisition is
+ *                           restarted. Out of range values are clamped.
+ *
+ *    samplingFrequency - ADC sampling frequency in Hz, adjusted to a whole
+ *                        number of samples per cycle when mains
+ *                        synchronised
+ *    windowSize - raw samples per window, rounded down to whole mains
+ *                 cycles when mains synchronised
+ *    oversamplingBits - extra bits gained by oversampling and decimation,
+ *                       the oversampling ratio is 4^oversamplingBits
+ *    refScan - scan the reference channels ahead of every window
+ *    mains - MultimeterAcqMains setting, Auto keeps a mains frequency it
+ *            already detected
+ *
+ * @return  true on success, false if a running acquisition could not be
+ *          restarted
+ */
+extern bool MultimeterAcq_configure(uint32_t samplingFrequency, uint16_t windowSize,
+                                    uint8_t oversamplingBits, bool refScan,
+                                    MultimeterAcqMains mains);
+
+/*
+ * MultimeterAcq_getConfig - Returns the settings as requested, before mains
+ *                           synchronisation and the adaptive window.
+ *
+ *    pConfig - settings output
+ */
+extern void MultimeterAcq_getConfig(multimeterAcqConfig_t *pConfig);
+
+/*
+ * MultimeterAcq_requireRefScan - Runs the reference scan whatever the
+ *                                configuration while required. The ADC is
+ *                                reopened and a running acquisition
+ *                                restarted like MultimeterAcq_configure.
+ *
+ *    required - the reference channels are required
+ *
+ * @return  true on success, false if a running acquisition could not be
+ *          restarted
+ */
+extern bool MultimeterAcq_requireRefScan(bool required);
+
+/*
+ * MultimeterAcq_getMains - Returns the mains synchronisation setting.
+ */
+extern MultimeterAcqMains MultimeterAcq_getMains(void);
+
+/*
+ * MultimeterAcq_getMainsFrequency - Returns the mains frequency the windows
+ *                                   are synchronised to, 0 if none (yet).
+ */
+extern uint8_t MultimeterAcq_getMainsFrequency(void);
+
+/*
+ * MultimeterAcq_isMainsSynchronous - Returns true if every window spans a
+ *                                    whole number of mains cycles, which is
+ *                                    also the case while detecting.
+ */
+extern bool MultimeterAcq_isMainsSynchronous(void);
+
+/*
+ * MultimeterAcq_isDetectingMains - Returns true while the mains frequency
+ *                                  still has to be detected.
+ */
+extern bool MultimeterAcq_isDetectingMains(void);
+
+/*
+ * MultimeterAcq_detectMains - Detects the mains frequency on a window of raw
+ *                             codes taken while detecting and switches to
+ *                             windows synchronised to it.
+ *
+ *    samples - raw ADC codes
+ *    count - number of samples
+ *
+ * @return  true if acquisition was restarted, the window must be dropped
+ */
+extern bool MultimeterAcq_detectMains(const uint16_t *samples, uint16_t count);
+
+/*
+ * MultimeterAcq_setAdaptiveWindow - Lets the window size follow the noise of
+ *                                   the signal. The window configured with
+ *                                   MultimeterAcq_configure is the upper
+ *                                   bound.
+ *
+ *    minWindowSize - lower bound of the window size
+ *    noiseMicroVolt - target noise of a reading in uV at the ADC input,
+ *                     0 for a fixed window
+ *
+ * @return  true on success, false otherwise
+ */
+extern bool MultimeterAcq_setAdaptiveWindow(uint16_t minWindowSize, uint32_t noiseMicroVolt);
+
+/*
+ * MultimeterAcq_adaptWindow - Resizes the adaptive window from the variance
+ *                             of the last window. May restart acquisition.
+ *
+ *    variance - sample variance of the reduced (decimated) codes
+ */
+extern void MultimeterAcq_adaptWindow(uint32_t variance);
+
+/*
+ * MultimeterAcq_getMinWindowSize - Returns the lower bound of the adaptive
+ *                                  window.
+ */
+extern uint16_t MultimeterAcq_getMinWindowSize(void);
+
+/*
+ * MultimeterAcq_getNoiseTarget - Returns the target noise of the adaptive
+ *                                window in uV, 0 for a fixed window.
+ */
+extern uint32_t MultimeterAcq_getNoiseTarget(void);
+
+/*
+ * MultimeterAcq_getCurrentWindowSize - Returns the number of samples of the
+ *                                      window being acquired.
+ */
+extern uint16_t MultimeterAcq_getCurrentWindowSize(void);
+
+/*
+ * MultimeterAcq_getRefScan - Returns true if the configuration enables the
+ *                            reference scan.
+ */
+extern bool MultimeterAcq_getRefScan(void);
+
+/*
+ * MultimeterAcq_getOversamplingBits - Returns the number of oversampling bits.
+ */
+extern uint8_t MultimeterAcq_getOversamplingBits(void);
+
+/*
+ * MultimeterAcq_getSamplingFrequency - Returns the sampling frequency in Hz.
+ */
+extern uint32_t MultimeterAcq_getSamplingFrequency(void);
+
+/*
+ * MultimeterAcq_getWindowSize - Returns the configured number of samples per
+ *                               window.
+ */
+extern uint16_t MultimeterAcq_getWindowSize(void);
+
+/*
+ * MultimeterAcq_getWindow - Takes the oldest queued window. Windows whose
+ *                           buffer has already been refilled are skipped,
+ *                           samples taken while the front end settled are
+ *                           cut off in whole oversampling groups, and
+ *                           windows left with less than one group are
+ *                           skipped.
+ *                           Must be followed by MultimeterAcq_releaseWindow
+ *                           once the samples have been reduced.
+ *
+ *    pWindow - completed window output
+ *
+ * @return  true if a window was ready, false otherwise
+ */
+extern bool MultimeterAcq_getWindow(multimeterAcqWindow_t *pWindow);
+
+/*
+ * MultimeterAcq_releaseWindow - Ends the use of the samples of a window
+ *                               taken by MultimeterAcq_getWindow.
+ *
+ *    pWindow - window to release
+ *
+ * @return  true if the samples were intact until now, false if the driver
+ *          started overwriting them and any result must be discarded
+ */
+extern bool MultimeterAcq_releaseWindow(const multimeterAcqWindow_t *pWindow);
+
+/*
+ * MultimeterAcq_getHandle - Returns the ADCBuf handle (NULL while closed).
+ */
+extern ADCBuf_Handle MultimeterAcq_getHandle(void);
+
+/*
+ * MultimeterAcq_codeToMicroVolts - Applies the ADC gain/offset trim to a
+ *                                  single reduced raw code and converts it
+ *                                  to microvolts.
+ *
+ *    code - raw ADC code with fracBits fractional bits
+ *    fracBits - fractional bits of code, e.g. from oversampling
+ *    pMicroVolt - converted voltage output
+ *
+ * @return  true on success, false if the ADC is closed or the driver
+ *          rejected the conversion
+ */
+extern bool MultimeterAcq_codeToMicroVolts(uint32_t code, uint8_t fracBits,
+                                           uint32_t *pMicroVolt);
+
+/*
+ * MultimeterAcq_codeSpanToMicroVolts - Converts a difference of raw codes,
+ *                                      such as an RMS, to microvolts. The
+ *                                      ADC offset cancels out.
+ *
+ *    span - code difference with fracBits fractional bits
+ *    fracBits - fractional bits of span
+ *    pMicroVolt - converted voltage output
+ *
+ * @return  true on success, false if the ADC is closed or the driver
+ *          rejected the conversion
+ */
+extern bool MultimeterAcq_codeSpanToMicroVolts(uint32_t span, uint8_t fracBits,
+                                               uint32_t *pMicroVolt);
+
+/*
+ * MultimeterAcq_microVoltsToCode - Returns the lowest raw code converting to
+ *                                  at least a voltage, so thresholds can be
+ *                                  compared with raw samples.
+ *
+ *    microVolt - voltage at the ADC input
+ *    pCode - raw code output, 0xFFF if no code reaches the voltage
+ *
+ * @return  true on success, false if the ADC is closed or the driver
+ *          rejected the conversion
+ */
+extern bool MultimeterAcq_microVoltsToCode(uint32_t microVolt, uint16_t *pCode);
+
+/*
+ * MultimeterAcq_isRunning - Returns true while conversions are running.
+ */
+extern bool MultimeterAcq_isRunning(void);
+
+/*
+ * MultimeterAcq_getOverrunCount - Returns the number of windows that were
+ *                                 lost or overwritten because the
+ *                                 application did not release them in time.
+ */
+extern uint32_t MultimeterAcq_getOverrunCount(void);
+
+/*
+ * MultimeterAcq_getOverflowCount - Returns the number of windows dropped
+ *                                  because the descriptor ring was full.
+ */
+extern uint32_t MultimeterAcq_getOverflowCount(void);
+
+/*********************************************************************
+*********************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MULTIMETER_ACQ_H */
@@ -0,0 +1,288 @@
+/******************************************************************************
+
+ @file  multimeter_bench.c
+
+ @brief This file contains the Multimeter cycle counter helpers and the on-target
+        benchmarks. The benchmarks are only built when MULTIMETER_BENCHMARK
+        is defined.
+
+ Group: WCS, BTS
+ Target Device: CC1350
+
+ ******************************************************************************
+
+ Copyright (c) 2013-2017, Texas Instruments Incorporated
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+
+ *  Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+ *  Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+ *  Neither the name of Texas Instruments Incorporated nor the names of
+    its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ Release Name: ti-ble-2.3.2-stack-sdk_1_50_xx
+ Release Date: 2017-09-27 14:52:16
+ *****************************************************************************/
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include "multimeter_bench.h"
+
+#ifdef MULTIMETER_BENCHMARK
+#include "multimeter_acq.h"
+#include "multimeter_reduce.h"
+#include "multimeter_spectrum.h"
+#include "multimeter_histogram.h"
+#include "multimeter_continuity.h"
+#endif // MULTIMETER_BENCHMARK
+
+/*********************************************************************
+ * CONSTANTS
+ */
+
+#ifdef MULTIMETER_BENCHMARK
+// Largest benchmarked window, the largest the acquisition can deliver
+#define BENCH_MAX_WINDOW_SIZE                 MULTIMETER_ACQ_MAX_WINDOW_SIZE
+
+// First display row used for the results
+#define BENCH_DISPLAY_ROW                     6
+#endif // MULTIMETER_BENCHMARK
+
+/*********************************************************************
+ * LOCAL VARIABLES
+ */
+
+#ifdef MULTIMETER_BENCHMARK
+// Benchmarked window sizes
+static const uint16_t benchWindowSizes[] = {
+  100, 256, 512,
+#if MULTIMETER_ACQ_MAX_WINDOW_SIZE >= 1024
+  1024,
+#endif
+#if MULTIMETER_ACQ_MAX_WINDOW_SIZE >= 2048
+  2048,
+#endif
+#if MULTIMETER_ACQ_MAX_WINDOW_SIZE >= 4096
+  4096,
+#endif
+};
+
+// Benchmarked oversampling bits
+static const uint8_t benchOversamplingBits[] = { 1, 2, 3, 4 };
+
+// Benchmarked spectrum window sizes
+static const uint16_t benchSpectrumSizes[] = { 64, 128, 256, 512, 1024 };
+
+// Synthetic window
+static uint16_t benchWindow[BENCH_MAX_WINDOW_SIZE];
+#endif // MULTIMETER_BENCHMARK
+
+/*********************************************************************
+ * LOCAL FUNCTIONS
+ */
+#ifdef MULTIMETER_BENCHMARK
+static void MultimeterBench_fillWindow(void);
+#endif // MULTIMETER_BENCHMARK
+
+/*********************************************************************
+ * PUBLIC FUNCTIONS
+ */
+
+/*********************************************************************
+ * @fn      MultimeterBench_initCycleCounter
+ *
+ * @brief   Enables the DWT cycle counter.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+void MultimeterBench_initCycleCounter(void)
+{
+  MULTIMETER_BENCH_DEMCR |= MULTIMETER_BENCH_DEMCR_TRCENA;
+  MULTIMETER_BENCH_DWT_CYCCNT = 0;
+  MULTIMETER_BENCH_DWT_CTRL |= MULTIMETER_BENCH_DWT_CTRL_CYCCNTENA;
+}
+
+#ifdef MULTIMETER_BENCHMARK
+/*********************************************************************
+ * @fn      MultimeterBench_run
+ *
+ * @brief   Runs the reducer benchmarks and prints cycles per window.
+ *
+ * @param   dispHandle - display to print the results on.
+ *
+ * @return  None.
+ */
+void MultimeterBench_run(Display_Handle dispHandle)
+{
+  uint32_t start;
+  uint32_t cycles;
+  uint16_t i;
+  uint8_t row = BENCH_DISPLAY_ROW;
+
+  MultimeterBench_initCycleCounter();
+  MultimeterBench_fillWindow();
+
+  for (i = 0; i < sizeof(benchWindowSizes) / sizeof(benchWindowSizes[0]); i++)
+  {
+    start = MULTIMETER_BENCH_CYCLES();
+    (void)MultimeterReduce_median(benchWindow, benchWindowSizes[i]);
+    cycles = MULTIMETER_BENCH_CYCLES() - start;
+
+    Display_print2(dispHandle, row++, 0, "median n=%d: %d cyc",
+                   benchWindowSizes[i], cycles);
+  }
+
+  // Robust means with their default parameters. The exponential average
+  // only adds a few cycles per window to the sum of the median pass.
+  for (i = 0; i < sizeof(benchWindowSizes) / sizeof(benchWindowSizes[0]); i++)
+  {
+    uint32_t hampelCycles;
+    uint16_t median = MultimeterReduce_median(benchWindow, benchWindowSizes[i]);
+
+    start = MULTIMETER_BENCH_CYCLES();
+    (void)MultimeterReduce_trimmedMean(benchWindow, benchWindowSizes[i],
+                                       MULTIMETER_REDUCE_CODE_BITS,
+                                       MULTIMETER_REDUCE_DEFAULT_TRIM);
+    cycles = MULTIMETER_BENCH_CYCLES() - start;
+
+    start = MULTIMETER_BENCH_CYCLES();
+    (void)MultimeterReduce_hampelMean(benchWindow, benchWindowSizes[i],
+                                      MULTIMETER_REDUCE_CODE_BITS, median,
+                                      MULTIMETER_REDUCE_DEFAULT_HAMPEL);
+    hampelCycles = MULTIMETER_BENCH_CYCLES() - start;
+
+    Display_print3(dispHandle, row++, 0, "trim/hampel n=%d: %d/%d cyc",
+                   benchWindowSizes[i], cycles, hampelCycles);
+  }
+
+  // Decimation cost per output sample over the largest window. The filter
+  // works in place, so the window is regenerated afterwards.
+  for (i = 0; i < sizeof(benchOversamplingBits) / sizeof(benchOversamplingBits[0]); i++)
+  {
+    uint16_t outputs;
+
+    start = MULTIMETER_BENCH_CYCLES();
+    outputs = MultimeterReduce_decimate(benchWindow, BENCH_MAX_WINDOW_SIZE,
+                                        benchOversamplingBits[i]);
+    cycles = MULTIMETER_BENCH_CYCLES() - start;
+
+    Display_print2(dispHandle, row++, 0, "decimate osr=%d: %d cyc/out",
+                   1 << (2 * benchOversamplingBits[i]), cycles / outputs);
+
+    MultimeterBench_fillWindow();
+  }
+
+  // True RMS sums per sample over the largest window
+  {
+    uint32_t sum;
+    uint64_t sumSquares;
+
+    start = MULTIMETER_BENCH_CYCLES();
+    MultimeterReduce_sumSquares(benchWindow, BENCH_MAX_WINDOW_SIZE, &sum, &sumSquares);
+    cycles = MULTIMETER_BENCH_CYCLES() - start;
+
+    Display_print1(dispHandle, row++, 0, "rms sums: %d cyc/sample",
+                   cycles / BENCH_MAX_WINDOW_SIZE);
+  }
+
+  // Spectrum cost per bin and window, a bank costs this times its bins
+  for (i = 0; i < sizeof(benchSpectrumSizes) / sizeof(benchSpectrumSizes[0]); i++)
+  {
+    int32_t coeff = MultimeterSpectrum_coeff(1000, 8000);
+
+    start = MULTIMETER_BENCH_CYCLES();
+    (void)MultimeterReduce_tonePower(benchWindow, benchSpectrumSizes[i], coeff);
+    cycles = MULTIMETER_BENCH_CYCLES() - start;
+
+    Display_print2(dispHandle, row++, 0, "goertzel n=%d: %d cyc/bin",
+                   benchSpectrumSizes[i], cycles);
+  }
+
+  // Histogram cost per sample over the largest window, half of the
+  // samples fall outside the bins. The histogram is left off.
+  {
+    multimeterHistogramConfig_t config = { 1984, 2, 32, 0xFFFF };
+    multimeterHistogramConfig_t offConfig = { 0, 0, 1, 0 };
+
+    (void)MultimeterHistogram_configure(&config);
+    start = MULTIMETER_BENCH_CYCLES();
+    MultimeterHistogram_process(benchWindow, BENCH_MAX_WINDOW_SIZE);
+    (void)MultimeterHistogram_commit();
+    cycles = MULTIMETER_BENCH_CYCLES() - start;
+
+    (void)MultimeterHistogram_configure(&offConfig);
+
+    Display_print1(dispHandle, row++, 0, "histogram: %d cyc/sample",
+                   cycles / BENCH_MAX_WINDOW_SIZE);
+  }
+
+  // Continuity detector per sample, the synthetic signal crosses both
+  // thresholds. Together with the window length this bounds the latency
+  // reported at run time in the status characteristic.
+  {
+    multimeterContinuityResult_t result;
+
+    MultimeterContinuity_configure(2040, 2056);
+    start = MULTIMETER_BENCH_CYCLES();
+    MultimeterContinuity_process(benchWindow, BENCH_MAX_WINDOW_SIZE, &result);
+    cycles = MULTIMETER_BENCH_CYCLES() - start;
+
+    Display_print1(dispHandle, row++, 0, "continuity: %d cyc/sample",
+                   cycles / BENCH_MAX_WINDOW_SIZE);
+  }
+}
+
+/*********************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+/*********************************************************************
+ * @fn      MultimeterBench_fillWindow
+ *
+ * @brief   Fills the benchmark window with a noisy mid-scale signal from a
+ *          linear congruential generator.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+static void MultimeterBench_fillWindow(void)
+{
+  uint32_t seed = 12345;
+  uint16_t i;
+
+  for (i = 0; i < BENCH_MAX_WINDOW_SIZE; i++)
+  {
+    seed = seed * 1103515245 + 12345;
+    benchWindow[i] = 2048 + ((seed >> 16) & 0xFF) - 128;
+  }
+}
+#endif // MULTIMETER_BENCHMARK
+
+/*********************************************************************
+*********************************************************************/
@@ -0,0 +1,112 @@
+/******************************************************************************
+
+ @file  multimeter_bench.h
+
+ @brief This file contains the Multimeter cycle counter helpers and the on-target
+        benchmark definitions.
+
+ Group: WCS, BTS
+ Target Device: CC1350
+
+ ******************************************************************************
+
+ Copyright (c) 2013-2017, Texas Instruments Incorporated
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+
+ *  Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+ *  Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+ *  Neither the name of Texas Instruments Incorporated nor the names of
+    its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ Release Name: ti-ble-2.3.2-stack-sdk_1_50_xx
+ Release Date: 2017-09-27 14:52:16
+ *****************************************************************************/
+
+#ifndef MULTIMETER_BENCH_H
+#define MULTIMETER_BENCH_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include <stdint.h>
+
+#ifdef USE_CORE_SDK
+  #include <ti/display/Display.h>
+#else // !USE_CORE_SDK
+  #include <ti/mw/display/Display.h>
+#endif // USE_CORE_SDK
+
+/*********************************************************************
+ * CONSTANTS
+ */
+
+// Cortex-M3 debug and trace registers used for cycle counting
+#define MULTIMETER_BENCH_DEMCR                (*(volatile uint32_t *)0xE000EDFC)
+#define MULTIMETER_BENCH_DWT_CTRL             (*(volatile uint32_t *)0xE0001000)
+#define MULTIMETER_BENCH_DWT_CYCCNT           (*(volatile uint32_t *)0xE0001004)
+
+#define MULTIMETER_BENCH_DEMCR_TRCENA         0x01000000
+#define MULTIMETER_BENCH_DWT_CTRL_CYCCNTENA   0x00000001
+
+/*********************************************************************
+ * MACROS
+ */
+
+// Current CPU cycle count, wraps every 2^32 cycles
+#define MULTIMETER_BENCH_CYCLES()             (MULTIMETER_BENCH_DWT_CYCCNT)
+
+/*********************************************************************
+ * FUNCTIONS
+ */
+
+/*
+ * MultimeterBench_initCycleCounter - Enables the DWT cycle counter.
+ */
+extern void MultimeterBench_initCycleCounter(void);
+
+#ifdef MULTIMETER_BENCHMARK
+/*
+ * MultimeterBench_run - Runs the reducer benchmarks on synthetic windows
+ *                       and prints the cycles per window on the display.
+ *
+ *    dispHandle - display to print the results on
+ */
+extern void MultimeterBench_run(Display_Handle dispHandle);
+#endif // MULTIMETER_BENCHMARK
+
+/*********************************************************************
+*********************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MULTIMETER_BENCH_H */
@@ -0,0 +1,273 @@
+/******************************************************************************
+
+ @file  multimeter_cal.c
+
+ @brief This file contains the Multimeter calibration tables. Every range
+        can have a piecewise-linear correction of its nominal readings,
+        kept in SNV and loaded into RAM at init.
+
+ Group: WCS, BTS
+ Target Device: CC1350
+
+ ******************************************************************************
+
+ Copyright (c) 2013-2017, Texas Instruments Incorporated
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+
+ *  Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+ *  Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+ *  Neither the name of Texas Instruments Incorporated nor the names of
+    its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ Release Name: ti-ble-2.3.2-stack-sdk_1_50_xx
+ Release Date: 2017-09-27 14:52:16
+ *****************************************************************************/
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include "osal_snv.h"
+
+#include "multimeter_cal.h"
+
+/*********************************************************************
+ * CONSTANTS
+ */
+
+// SNV item of the table of mode 0, one item per mode. The application
+// range holds 16 items, enough for every MultimeterMode.
+#define CAL_NVID_BASE                         BLE_NVID_CUST_START
+
+// Fractional bits of the segment slopes
+#define CAL_SLOPE_SHIFT                       16
+
+/*********************************************************************
+ * LOCAL VARIABLES
+ */
+
+// Tables in use, indexed by MultimeterMode
+static multimeterCalTable_t calTables[MultimeterMode_Count];
+
+// Slope of segment i, from point i to point i + 1, computed once so a
+// reading needs no division
+static int32_t calSlopes[MultimeterMode_Count][MULTIMETER_CAL_MAX_POINTS - 1];
+
+/*********************************************************************
+ * LOCAL FUNCTIONS
+ */
+static bool MultimeterCal_isValid(const multimeterCalTable_t *pTable);
+static void MultimeterCal_load(MultimeterMode mode, const multimeterCalTable_t *pTable);
+
+/*********************************************************************
+ * PUBLIC FUNCTIONS
+ */
+
+/*********************************************************************
+ * @fn      MultimeterCal_init
+ *
+ * @brief   Loads the calibration tables from SNV. A missing or invalid
+ *          item leaves its range uncalibrated.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+void MultimeterCal_init(void)
+{
+  multimeterCalTable_t table;
+  uint8_t mode;
+
+  for (mode = 0; mode < MultimeterMode_Count; mode++)
+  {
+    calTables[mode].count = 0;
+
+    if (osal_snv_read(CAL_NVID_BASE + mode, sizeof(table), &table) == SUCCESS &&
+        MultimeterCal_isValid(&table))
+    {
+      MultimeterCal_load((MultimeterMode)mode, &table);
+    }
+  }
+}
+
+/*********************************************************************
+ * @fn      MultimeterCal_setTable
+ *
+ * @brief   Validates a calibration table, stores it in SNV and uses it
+ *          from now on.
+ *
+ * @param   mode - multimeter range.
+ * @param   pTable - new table.
+ *
+ * @return  true on success, false otherwise.
+ */
+bool MultimeterCal_setTable(MultimeterMode mode, const multimeterCalTable_t *pTable)
+{
+  if (mode >= MultimeterMode_Count || !MultimeterCal_isValid(pTable))
+  {
+    return (false);
+  }
+
+  if (osal_snv_write(CAL_NVID_BASE + mode, sizeof(*pTable), (void *)pTable) != SUCCESS)
+  {
+    return (false);
+  }
+
+  MultimeterCal_load(mode, pTable);
+
+  return (true);
+}
+
+/*********************************************************************
+ * @fn      MultimeterCal_getCount
+ *
+ * @brief   Returns the number of points of a range's table.
+ *
+ * @param   mode - multimeter range.
+ *
+ * @return  Number of points, 0 if uncalibrated.
+ */
+uint8_t MultimeterCal_getCount(MultimeterMode mode)
+{
+  if (mode >= MultimeterMode_Count)
+  {
+    return (0);
+  }
+
+  return (calTables[mode].count);
+}
+
+/*********************************************************************
+ * @fn      MultimeterCal_apply
+ *
+ * @brief   Calibrates a nominal reading, a binary search for the segment
+ *          and one fixed-point multiplication.
+ *
+ * @param   mode - multimeter range.
+ * @param   reading - nominal reading in the range's unit.
+ *
+ * @return  Calibrated reading.
+ */
+int32_t MultimeterCal_apply(MultimeterMode mode, int32_t reading)
+{
+  const multimeterCalTable_t *pTable;
+  uint8_t low;
+  uint8_t high;
+  uint8_t mid;
+
+  if (mode >= MultimeterMode_Count || calTables[mode].count == 0)
+  {
+    return (reading);
+  }
+  pTable = &calTables[mode];
+
+  if (pTable->count == 1)
+  {
+    return (reading + (pTable->output[0] - pTable->input[0]));
+  }
+
+  // last segment starting at or below the reading, the end segments
+  // extend beyond the table
+  low = 0;
+  high = pTable->count - 2;
+  while (low < high)
+  {
+    mid = (low + high + 1) / 2;
+    if (pTable->input[mid] <= reading)
+    {
+      low = mid;
+    }
+    else
+    {
+      high = mid - 1;
+    }
+  }
+
+  return (pTable->output[low] +
+          (int32_t)(((int64_t)(reading - pTable->input[low]) * calSlopes[mode][low]) >>
+                    CAL_SLOPE_SHIFT));
+}
+
+/*********************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+/*********************************************************************
+ * @fn      MultimeterCal_isValid
+ *
+ * @brief   Checks the number of points and the order of the inputs.
+ *
+ * @param   pTable - table to check.
+ *
+ * @return  true if valid, false otherwise.
+ */
+static bool MultimeterCal_isValid(const multimeterCalTable_t *pTable)
+{
+  uint8_t i;
+
+  if (pTable->count > MULTIMETER_CAL_MAX_POINTS)
+  {
+    return (false);
+  }
+
+  for (i = 1; i < pTable->count; i++)
+  {
+    if (pTable->input[i] <= pTable->input[i - 1])
+    {
+      return (false);
+    }
+  }
+
+  return (true);
+}
+
+/*********************************************************************
+ * @fn      MultimeterCal_load
+ *
+ * @brief   Copies a valid table into RAM and computes its slopes.
+ *
+ * @param   mode - multimeter range.
+ * @param   pTable - table to load.
+ *
+ * @return  None.
+ */
+static void MultimeterCal_load(MultimeterMode mode, const multimeterCalTable_t *pTable)
+{
+  int64_t rise;
+  int64_t run;
+  uint8_t i;
+
+  calTables[mode] = *pTable;
+
+  for (i = 0; i + 1 < pTable->count; i++)
+  {
+    rise = (int64_t)pTable->output[i + 1] - pTable->output[i];
+    run = (int64_t)pTable->input[i + 1] - pTable->input[i];
+    calSlopes[mode][i] = (int32_t)((rise << CAL_SLOPE_SHIFT) / run);
+  }
+}
+
+/*********************************************************************
+*********************************************************************/
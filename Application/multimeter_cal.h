@@ -0,0 +1,130 @@
+/******************************************************************************
+
+ @file  multimeter_cal.h
+
+ @brief This file contains the Multimeter calibration table definitions
+        and prototypes.
+
+ Group: WCS, BTS
+ Target Device: CC1350
+
+ ******************************************************************************
+
+ Copyright (c) 2013-2017, Texas Instruments Incorporated
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+
+ *  Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+ *  Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+ *  Neither the name of Texas Instruments Incorporated nor the names of
+    its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ Release Name: ti-ble-2.3.2-stack-sdk_1_50_xx
+ Release Date: 2017-09-27 14:52:16
+ *****************************************************************************/
+
+#ifndef MULTIMETER_CAL_H
+#define MULTIMETER_CAL_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "bcomdef.h"
+#include "../profiles/multimeter_gatt_profile.h"
+
+/*********************************************************************
+ * CONSTANTS
+ */
+
+// Largest number of points of a calibration table
+#define MULTIMETER_CAL_MAX_POINTS             8
+
+/*********************************************************************
+ * TYPEDEFS
+ */
+
+// Piecewise-linear calibration of one range, stored as is in SNV. Nominal
+// readings between two points are interpolated, beyond the first or the
+// last point the end segment is extended. A single point shifts the
+// readings, no point leaves them unchanged.
+typedef struct
+{
+  uint8_t count;                              // Number of points
+  int32_t input[MULTIMETER_CAL_MAX_POINTS];   // Nominal readings, strictly increasing
+  int32_t output[MULTIMETER_CAL_MAX_POINTS];  // Calibrated readings
+} multimeterCalTable_t;
+
+/*********************************************************************
+ * FUNCTIONS
+ */
+
+/*
+ * MultimeterCal_init - Loads the calibration tables from SNV.
+ */
+extern void MultimeterCal_init(void);
+
+/*
+ * MultimeterCal_setTable - Validates a calibration table, stores it in SNV
+ *                          and uses it from now on.
+ *
+ *    mode - multimeter range
+ *    pTable - new table, count 0 removes the calibration
+ *
+ * @return  true on success, false if the table is invalid or could not
+ *          be stored
+ */
+extern bool MultimeterCal_setTable(MultimeterMode mode, const multimeterCalTable_t *pTable);
+
+/*
+ * MultimeterCal_getCount - Returns the number of points of a range's table.
+ *
+ *    mode - multimeter range
+ */
+extern uint8_t MultimeterCal_getCount(MultimeterMode mode);
+
+/*
+ * MultimeterCal_apply - Calibrates a nominal reading.
+ *
+ *    mode - multimeter range
+ *    reading - nominal reading in the range's unit
+ */
+extern int32_t MultimeterCal_apply(MultimeterMode mode, int32_t reading);
+
+/*********************************************************************
+*********************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MULTIMETER_CAL_H */
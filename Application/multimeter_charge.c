@@ -0,0 +1,154 @@
+/******************************************************************************
+
+ @file  multimeter_charge.c
+
+ @brief This file contains the Multimeter charge and energy counter. In
+        the 500mA range every sample is integrated into 64-bit charge and
+        energy accumulators, independently of the reporting period and of
+        the BLE connection.
+
+ Group: WCS, BTS
+ Target Device: CC1350
+
+ ******************************************************************************
+
+ Copyright (c) 2013-2017, Texas Instruments Incorporated
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+
+ *  Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+ *  Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+ *  Neither the name of Texas Instruments Incorporated nor the names of
+    its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ Release Name: ti-ble-2.3.2-stack-sdk_1_50_xx
+ Release Date: 2017-09-27 14:52:16
+ *****************************************************************************/
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include "multimeter_charge.h"
+
+/*********************************************************************
+ * CONSTANTS
+ */
+
+// pC per uAh and pJ per uWh
+#define CHARGE_PER_MICRO_HOUR                 3600000000LL
+
+// Microseconds per second
+#define CHARGE_MICROSECONDS                   1000000LL
+
+// uA * uV = 1000 nW, nW * us = 1000 pJ
+#define CHARGE_NANO_PER_MICRO                 1000LL
+
+/*********************************************************************
+ * LOCAL VARIABLES
+ */
+
+// Charge in pC, energy in pJ and integration time in us. 64 bits hold
+// more than 2500 Ah and 2500 Wh.
+static int64_t chargePicoCoulomb = 0;
+static int64_t chargePicoJoule = 0;
+static uint64_t chargeMicroSeconds = 0;
+
+// Voltage the energy is integrated with, 0 if none
+static int32_t chargeMicroVolt = 0;
+
+/*********************************************************************
+ * PUBLIC FUNCTIONS
+ */
+
+/*********************************************************************
+ * @fn      MultimeterCharge_reset
+ *
+ * @brief   Clears the charge, energy and time. The voltage is kept.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+void MultimeterCharge_reset(void)
+{
+  chargePicoCoulomb = 0;
+  chargePicoJoule = 0;
+  chargeMicroSeconds = 0;
+}
+
+/*********************************************************************
+ * @fn      MultimeterCharge_setVoltage
+ *
+ * @brief   Sets the voltage the energy is integrated with from now on.
+ *
+ * @param   microVolt - voltage in uV, signed.
+ *
+ * @return  None.
+ */
+void MultimeterCharge_setVoltage(int32_t microVolt)
+{
+  chargeMicroVolt = microVolt;
+}
+
+/*********************************************************************
+ * @fn      MultimeterCharge_add
+ *
+ * @brief   Integrates a current over a stretch of time. The power is
+ *          rounded to nW first so a long stretch cannot overflow.
+ *
+ * @param   microAmp - mean current in uA.
+ * @param   microSeconds - time the current flowed in us.
+ *
+ * @return  None.
+ */
+void MultimeterCharge_add(int32_t microAmp, uint32_t microSeconds)
+{
+  int64_t nanoWatt = ((int64_t)microAmp * chargeMicroVolt) / CHARGE_NANO_PER_MICRO;
+
+  // uA * us = pC
+  chargePicoCoulomb += (int64_t)microAmp * microSeconds;
+  chargePicoJoule += (nanoWatt * microSeconds) / CHARGE_NANO_PER_MICRO;
+  chargeMicroSeconds += microSeconds;
+}
+
+/*********************************************************************
+ * @fn      MultimeterCharge_get
+ *
+ * @brief   Returns the totals since the last reset.
+ *
+ * @param   pSummary - totals output.
+ *
+ * @return  None.
+ */
+void MultimeterCharge_get(multimeterChargeSummary_t *pSummary)
+{
+  pSummary->microAmpHours = (int32_t)(chargePicoCoulomb / CHARGE_PER_MICRO_HOUR);
+  pSummary->microWattHours = (int32_t)(chargePicoJoule / CHARGE_PER_MICRO_HOUR);
+  pSummary->microVolt = chargeMicroVolt;
+  pSummary->seconds = (uint32_t)(chargeMicroSeconds / CHARGE_MICROSECONDS);
+}
+
+/*********************************************************************
+*********************************************************************/
@@ -0,0 +1,114 @@
+/******************************************************************************
+
+ @file  multimeter_charge.h
+
+ @brief This file contains the Multimeter charge and energy counter
+        definitions and prototypes.
+
+ Group: WCS, BTS
+ Target Device: CC1350
+
+ ******************************************************************************
+
+ Copyright (c) 2013-2017, Texas Instruments Incorporated
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+
+ *  Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+ *  Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+ *  Neither the name of Texas Instruments Incorporated nor the names of
+    its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ Release Name: ti-ble-2.3.2-stack-sdk_1_50_xx
+ Release Date: 2017-09-27 14:52:16
+ *****************************************************************************/
+
+#ifndef MULTIMETER_CHARGE_H
+#define MULTIMETER_CHARGE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************************************************************
+ * TYPEDEFS
+ */
+
+// Totals since the last reset
+typedef struct
+{
+  int32_t  microAmpHours;   // Charge in uAh
+  int32_t  microWattHours;  // Energy in uWh, 0 without a voltage
+  int32_t  microVolt;       // Voltage the energy is integrated with, 0 if none
+  uint32_t seconds;         // Integration time in s
+} multimeterChargeSummary_t;
+
+/*********************************************************************
+ * FUNCTIONS
+ */
+
+/*
+ * MultimeterCharge_reset - Clears the charge, energy and time.
+ */
+extern void MultimeterCharge_reset(void);
+
+/*
+ * MultimeterCharge_setVoltage - Sets the voltage the energy is integrated
+ *                               with from now on.
+ *
+ *    microVolt - voltage in uV
+ */
+extern void MultimeterCharge_setVoltage(int32_t microVolt);
+
+/*
+ * MultimeterCharge_add - Integrates a current over a stretch of time.
+ *
+ *    microAmp - mean current in uA
+ *    microSeconds - time the current flowed in us
+ */
+extern void MultimeterCharge_add(int32_t microAmp, uint32_t microSeconds);
+
+/*
+ * MultimeterCharge_get - Returns the totals since the last reset.
+ *
+ *    pSummary - totals output
+ */
+extern void MultimeterCharge_get(multimeterChargeSummary_t *pSummary);
+
+/*********************************************************************
+*********************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MULTIMETER_CHARGE_H */
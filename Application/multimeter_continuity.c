@@ -0,0 +1,137 @@
+/******************************************************************************
+
+ @file  multimeter_continuity.c
+
+ @brief This file contains the Multimeter continuity detector. A debounced
+        two threshold detector runs over every raw sample, so a change is
+        known at the end of the window it happened in.
+
+ Group: WCS, BTS
+ Target Device: CC1350
+
+ ******************************************************************************
+
+ Copyright (c) 2013-2017, Texas Instruments Incorporated
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+
+ *  Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+ *  Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+ *  Neither the name of Texas Instruments Incorporated nor the names of
+    its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ Release Name: ti-ble-2.3.2-stack-sdk_1_50_xx
+ Release Date: 2017-09-27 14:52:16
+ *****************************************************************************/
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include "multimeter_continuity.h"
+
+/*********************************************************************
+ * LOCAL VARIABLES
+ */
+
+// Thresholds in raw codes
+static uint16_t continuityCloseCode = 0;
+static uint16_t continuityOpenCode = 0;
+
+// Debounced state and the samples seen in a row against it. The run
+// carries over between windows, so an edge split by a window boundary is
+// still detected.
+static bool continuityClosed = false;
+static uint8_t continuityRun = 0;
+
+/*********************************************************************
+ * PUBLIC FUNCTIONS
+ */
+
+/*********************************************************************
+ * @fn      MultimeterContinuity_configure
+ *
+ * @brief   Sets the thresholds and restarts in the open state.
+ *
+ * @param   closeCode - raw codes below it count towards closed.
+ * @param   openCode - raw codes above it count towards open.
+ *
+ * @return  None.
+ */
+void MultimeterContinuity_configure(uint16_t closeCode, uint16_t openCode)
+{
+  continuityCloseCode = closeCode;
+  continuityOpenCode = (openCode > closeCode) ? openCode : closeCode;
+  continuityClosed = false;
+  continuityRun = 0;
+}
+
+/*********************************************************************
+ * @fn      MultimeterContinuity_process
+ *
+ * @brief   Runs the detector on a window. A sample on the other side of
+ *          the threshold of the opposite state extends the run, any
+ *          other sample ends it. A run of MULTIMETER_CONTINUITY_DEBOUNCE
+ *          samples changes the state. The gap between the thresholds
+ *          keeps noise around a single level from toggling it.
+ *
+ * @param   samples - raw ADC codes.
+ * @param   count - number of samples.
+ * @param   pResult - result output.
+ *
+ * @return  None.
+ */
+void MultimeterContinuity_process(const uint16_t *samples, uint16_t count,
+                                  multimeterContinuityResult_t *pResult)
+{
+  bool startClosed = continuityClosed;
+  bool against;
+  uint16_t i;
+
+  pResult->edgeAge = 0;
+
+  for (i = 0; i < count; i++)
+  {
+    against = continuityClosed ? (samples[i] > continuityOpenCode) :
+                                 (samples[i] < continuityCloseCode);
+    if (!against)
+    {
+      continuityRun = 0;
+    }
+    else if (++continuityRun >= MULTIMETER_CONTINUITY_DEBOUNCE)
+    {
+      continuityClosed = !continuityClosed;
+      continuityRun = 0;
+
+      // the run may have started in the previous window
+      pResult->edgeAge = (uint16_t)(count - i - 1 + MULTIMETER_CONTINUITY_DEBOUNCE);
+    }
+  }
+
+  pResult->changed = (continuityClosed != startClosed);
+  pResult->closed = continuityClosed;
+}
+
+/*********************************************************************
+*********************************************************************/
@@ -0,0 +1,113 @@
+/******************************************************************************
+
+ @file  multimeter_continuity.h
+
+ @brief This file contains the Multimeter continuity detector definitions
+        and prototypes.
+
+ Group: WCS, BTS
+ Target Device: CC1350
+
+ ******************************************************************************
+
+ Copyright (c) 2013-2017, Texas Instruments Incorporated
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+
+ *  Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+ *  Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+ *  Neither the name of Texas Instruments Incorporated nor the names of
+    its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ Release Name: ti-ble-2.3.2-stack-sdk_1_50_xx
+ Release Date: 2017-09-27 14:52:16
+ *****************************************************************************/
+
+#ifndef MULTIMETER_CONTINUITY_H
+#define MULTIMETER_CONTINUITY_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************************************************************
+ * CONSTANTS
+ */
+
+// Consecutive samples beyond a threshold that change the state
+#ifndef MULTIMETER_CONTINUITY_DEBOUNCE
+#define MULTIMETER_CONTINUITY_DEBOUNCE        4
+#endif
+
+/*********************************************************************
+ * TYPEDEFS
+ */
+
+// Result of a window
+typedef struct
+{
+  bool     changed;     // The state at the end differs from the one at the start
+  bool     closed;      // State at the end of the window
+  uint16_t edgeAge;     // Samples from the first one of the run that made the
+                        // last change to the end of the window
+} multimeterContinuityResult_t;
+
+/*********************************************************************
+ * FUNCTIONS
+ */
+
+/*
+ * MultimeterContinuity_configure - Sets the thresholds and restarts open.
+ *
+ *    closeCode - raw codes below it count towards closed
+ *    openCode - raw codes above it count towards open, at least closeCode
+ */
+extern void MultimeterContinuity_configure(uint16_t closeCode, uint16_t openCode);
+
+/*
+ * MultimeterContinuity_process - Runs the detector on a window.
+ *
+ *    samples - raw ADC codes
+ *    count - number of samples
+ *    pResult - result output
+ */
+extern void MultimeterContinuity_process(const uint16_t *samples, uint16_t count,
+                                         multimeterContinuityResult_t *pResult);
+
+/*********************************************************************
+*********************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MULTIMETER_CONTINUITY_H */
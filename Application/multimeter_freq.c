@@ -0,0 +1,705 @@
+/******************************************************************************
+
+ @file  multimeter_freq.c
+
+ @brief This file contains the Multimeter frequency counter. Crossings
+        of the continuous sample stream are qualified by hysteresis around
+        the middle of the signal swing and timed by interpolation at the
+        mid level, giving frequency, period and duty cycle. A clean logic
+        level signal can optionally be timed by a GPTimer edge capture
+        instead (MULTIMETER_FREQ_TIMER_CAPTURE).
+
+ Group: WCS, BTS
+ Target Device: CC1350
+
+ ******************************************************************************
+
+ Copyright (c) 2013-2017, Texas Instruments Incorporated
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+
+ *  Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+ *  Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+ *  Neither the name of Texas Instruments Incorporated nor the names of
+    its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ Release Name: ti-ble-2.3.2-stack-sdk_1_50_xx
+ Release Date: 2017-09-27 14:52:16
+ *****************************************************************************/
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include <stddef.h>
+
+#ifdef MULTIMETER_FREQ_TIMER_CAPTURE
+#include <ti/sysbios/hal/Hwi.h>
+#include <ti/drivers/PIN.h>
+#include <ti/drivers/pin/PINCC26XX.h>
+#include <ti/drivers/timer/GPTimerCC26XX.h>
+
+#include "board.h"
+#endif // MULTIMETER_FREQ_TIMER_CAPTURE
+
+#include "multimeter_freq.h"
+
+/*********************************************************************
+ * CONSTANTS
+ */
+
+// Crossing times are kept relative to the start of the interval and must
+// stay within int32_t with their fractional bits
+#define FREQ_MAX_SAMPLES                      (1L << (30 - MULTIMETER_FREQ_TIME_FRAC_BITS))
+
+// Fractional bits of the envelope, lets it decay by less than a code
+// per window at high sampling frequencies
+#define FREQ_ENVELOPE_FRAC_BITS               16
+
+#ifdef MULTIMETER_FREQ_TIMER_CAPTURE
+// Edge time mode extends the 16-bit timer with its prescaler to 24 bits
+#define FREQ_CAPTURE_MASK                     0xFFFFFF
+
+// Timer clock in Hz
+#define FREQ_CAPTURE_TIMEBASE                 48000000
+
+// Longest capture interval, keeps the span within 31 bits
+#define FREQ_CAPTURE_MAX_SPAN                 0x7F000000
+#endif // MULTIMETER_FREQ_TIMER_CAPTURE
+
+/*********************************************************************
+ * TYPEDEFS
+ */
+
+// Level of the input relative to the hysteresis thresholds
+typedef enum
+{
+  FreqLevel_Unknown = 0,
+  FreqLevel_Low,
+  FreqLevel_High
+} FreqLevel;
+
+// Crossing state of the ADC path
+typedef struct
+{
+  FreqLevel level;
+
+  // Previous sample, crossings are interpolated between it and the next one
+  uint16_t prev;
+  bool prevValid;
+
+  // Samples since the start of the interval, index of the next sample
+  int32_t position;
+
+  // Latest crossings of the mid level in either direction, in samples
+  // with MULTIMETER_FREQ_TIME_FRAC_BITS fractional bits
+  int32_t midRise;
+  int32_t midFall;
+
+  // Rising crossings in the interval, the first and the last of them
+  uint32_t rises;
+  int32_t firstRise;
+  int32_t lastRise;
+
+  // High time of the cycle in progress and of the complete cycles
+  int32_t pendingHigh;
+  uint32_t high;
+
+  // Samples of the interval and those between the thresholds
+  uint32_t samples;
+  uint32_t bandSamples;
+
+  // Smallest envelope swing of the interval
+  uint16_t minSwing;
+
+  // Min / max envelope of the input with FREQ_ENVELOPE_FRAC_BITS fractional
+  // bits. It follows a new extreme at once and decays towards the extremes
+  // of the later windows.
+  int32_t envelopeMin;
+  int32_t envelopeMax;
+  bool envelopeValid;
+
+  // Mid level and hysteresis, kept across windows, and the envelope swing
+  // they were placed for. A swing of 0 has them placed on the next window.
+  uint16_t mid;
+  uint16_t hysteresis;
+  uint16_t swing;
+} freqState_t;
+
+/*********************************************************************
+ * LOCAL VARIABLES
+ */
+
+// Crossing state of the ADC path, kept across windows
+static freqState_t freq = { FreqLevel_Unknown, 0, false, 0, 0, 0, 0, 0, 0, 0, 0,
+                            0, 0, 0xFFFF, 0, 0, false, 0, 0, 0 };
+
+// State before the window processed last, restored by
+// MultimeterFreq_rollback when the window's samples were overwritten
+static freqState_t freqSaved;
+
+#ifdef MULTIMETER_FREQ_TIMER_CAPTURE
+static GPTimerCC26XX_Handle captureTimer = NULL;
+static PIN_Handle capturePin = NULL;
+static PIN_State capturePinState;
+
+static PIN_Config capturePinTable[] =
+{
+  MULTIMETER_FREQ_CAPTURE_PIN | PIN_INPUT_EN | PIN_NOPULL,
+  PIN_TERMINATE
+};
+
+// Capture interval, written by the timer interrupt
+static volatile uint32_t captureRises = 0;
+static volatile uint32_t captureLastRise = 0;
+static volatile uint32_t captureSpan = 0;
+static volatile uint32_t capturePendingHigh = 0;
+static volatile uint32_t captureHigh = 0;
+#endif // MULTIMETER_FREQ_TIMER_CAPTURE
+
+/*********************************************************************
+ * LOCAL FUNCTIONS
+ */
+static int32_t MultimeterFreq_interpolate(uint16_t prev, uint16_t code, uint16_t mid);
+static void MultimeterFreq_rebase(int32_t origin);
+static void MultimeterFreq_track(uint16_t min, uint16_t max, uint16_t count,
+                                 uint32_t samplingFrequency);
+#ifdef MULTIMETER_FREQ_TIMER_CAPTURE
+static void MultimeterFreq_captureCB(GPTimerCC26XX_Handle handle,
+                                     GPTimerCC26XX_IntMask interruptMask);
+#endif // MULTIMETER_FREQ_TIMER_CAPTURE
+
+/*********************************************************************
+ * PUBLIC FUNCTIONS
+ */
+
+/*********************************************************************
+ * @fn      MultimeterFreq_reset
+ *
+ * @brief   Drops the crossing history and starts a new measurement
+ *          interval.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+void MultimeterFreq_reset(void)
+{
+  freq.level = FreqLevel_Unknown;
+  freq.prevValid = false;
+  freq.position = 0;
+  freq.midRise = 0;
+  freq.midFall = 0;
+  freq.rises = 0;
+  freq.firstRise = 0;
+  freq.lastRise = 0;
+  freq.pendingHigh = 0;
+  freq.high = 0;
+  freq.samples = 0;
+  freq.bandSamples = 0;
+  freq.minSwing = 0xFFFF;
+  freq.envelopeValid = false;
+  freq.swing = 0;
+}
+
+/*********************************************************************
+ * @fn      MultimeterFreq_process
+ *
+ * @brief   Finds the crossings of a window. The thresholds are placed
+ *          around the middle of the input's min / max envelope, and stay
+ *          where they are until the envelope's mid level moved by more
+ *          than the hysteresis or its swing changed markedly, so a signal
+ *          slower than the window rate is not cut into one cycle per
+ *          window. A rising crossing is counted when the input goes from
+ *          below the lower threshold to above the upper one, and the
+ *          other way round for a falling crossing. Either is timed at the
+ *          last time the input passed the mid level in its direction,
+ *          interpolated between samples, so the timing does not depend on
+ *          the hysteresis. The state before the window is kept for
+ *          MultimeterFreq_rollback.
+ *
+ * @param   samples - raw 12-bit ADC codes.
+ * @param   count - number of samples.
+ * @param   samplingFrequency - ADC sampling frequency in Hz.
+ *
+ * @return  None.
+ */
+void MultimeterFreq_process(const uint16_t *samples, uint16_t count,
+                            uint32_t samplingFrequency)
+{
+  const uint16_t *p;
+  const uint16_t *pEnd = samples + count;
+  uint16_t min = 0xFFFF;
+  uint16_t max = 0;
+  uint16_t mid;
+  uint16_t swing;
+  uint16_t hysteresis;
+  uint16_t low;
+  uint16_t high;
+  uint16_t code;
+
+  // Kept until the window proved intact
+  freqSaved = freq;
+
+  if (count == 0)
+  {
+    return;
+  }
+
+  // Start over before the crossing times run out of range
+  if (freq.position > FREQ_MAX_SAMPLES - count)
+  {
+    MultimeterFreq_reset();
+  }
+
+  for (p = samples; p < pEnd; p++)
+  {
+    if (*p < min)
+    {
+      min = *p;
+    }
+    if (*p > max)
+    {
+      max = *p;
+    }
+  }
+
+  MultimeterFreq_track(min, max, count, samplingFrequency);
+  swing = (uint16_t)((freq.envelopeMax - freq.envelopeMin) >> FREQ_ENVELOPE_FRAC_BITS);
+  mid = (uint16_t)((freq.envelopeMin + freq.envelopeMax) >> (FREQ_ENVELOPE_FRAC_BITS + 1));
+
+  if (swing < freq.minSwing)
+  {
+    freq.minSwing = swing;
+  }
+  freq.samples += count;
+
+  hysteresis = swing >> MULTIMETER_FREQ_HYSTERESIS_SHIFT;
+  if (hysteresis < MULTIMETER_FREQ_MIN_HYSTERESIS)
+  {
+    hysteresis = MULTIMETER_FREQ_MIN_HYSTERESIS;
+  }
+  if (swing < 4 * hysteresis)
+  {
+    // No signal, only noise around a level
+    freq.position += count;
+    freq.prevValid = false;
+    freq.swing = 0;
+    return;
+  }
+
+  // Re-centre only when the envelope really moved, otherwise its decay
+  // between the peaks of a slow signal would drag the thresholds along
+  if (freq.swing == 0 ||
+      mid + freq.hysteresis < freq.mid || mid > freq.mid + freq.hysteresis ||
+      swing + (freq.swing >> MULTIMETER_FREQ_RECENTRE_SHIFT) < freq.swing ||
+      swing > freq.swing + (freq.swing >> MULTIMETER_FREQ_RECENTRE_SHIFT))
+  {
+    freq.mid = mid;
+    freq.hysteresis = hysteresis;
+    freq.swing = swing;
+
+    // Crossings timed against the old mid level do not start a cycle
+    freq.rises = 0;
+    freq.high = 0;
+  }
+  mid = freq.mid;
+  low = mid - freq.hysteresis;
+  high = mid + freq.hysteresis;
+
+  for (p = samples; p < pEnd; p++, freq.position++)
+  {
+    code = *p;
+
+    if (freq.prevValid)
+    {
+      if (freq.prev < mid && code >= mid)
+      {
+        freq.midRise = ((freq.position - 1) << MULTIMETER_FREQ_TIME_FRAC_BITS) +
+                      MultimeterFreq_interpolate(freq.prev, code, mid);
+      }
+      else if (freq.prev >= mid && code < mid)
+      {
+        freq.midFall = ((freq.position - 1) << MULTIMETER_FREQ_TIME_FRAC_BITS) +
+                      MultimeterFreq_interpolate(freq.prev, code, mid);
+      }
+    }
+    freq.prev = code;
+    freq.prevValid = true;
+
+    if (code <= low)
+    {
+      if (freq.level == FreqLevel_High && freq.rises > 0)
+      {
+        freq.pendingHigh = freq.midFall - freq.lastRise;
+      }
+      freq.level = FreqLevel_Low;
+    }
+    else if (code >= high)
+    {
+      if (freq.level == FreqLevel_Low)
+      {
+        if (freq.rises == 0)
+        {
+          freq.firstRise = freq.midRise;
+        }
+        else
+        {
+          freq.high += (uint32_t)freq.pendingHigh;
+        }
+        freq.lastRise = freq.midRise;
+        freq.rises++;
+      }
+      freq.level = FreqLevel_High;
+    }
+    else
+    {
+      freq.bandSamples++;
+    }
+  }
+}
+
+/*********************************************************************
+ * @fn      MultimeterFreq_rollback
+ *
+ * @brief   Undoes the window processed last, for a window whose samples
+ *          the driver overwrote while they were read.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+void MultimeterFreq_rollback(void)
+{
+  freq = freqSaved;
+}
+
+/*********************************************************************
+ * @fn      MultimeterFreq_get
+ *
+ * @brief   Ends the measurement interval once it holds a complete cycle,
+ *          or with no cycles once it timed out. The next interval starts
+ *          at the last rising crossing, so no time is lost between
+ *          intervals.
+ *
+ * @param   pResult - result output.
+ * @param   samplingFrequency - ADC sampling frequency in Hz.
+ *
+ * @return  true if a result was produced.
+ */
+bool MultimeterFreq_get(multimeterFreqResult_t *pResult,
+                        uint32_t samplingFrequency)
+{
+  uint32_t timeout = (uint32_t)(((uint64_t)samplingFrequency * MULTIMETER_FREQ_TIMEOUT) / 1000);
+
+  pResult->timebase = samplingFrequency << MULTIMETER_FREQ_TIME_FRAC_BITS;
+  pResult->clean = (freq.minSwing >= MULTIMETER_FREQ_LOGIC_SWING) &&
+                   (freq.minSwing != 0xFFFF) &&
+                   ((freq.bandSamples << MULTIMETER_FREQ_CLEAN_SHIFT) < freq.samples);
+
+  if (freq.rises >= 2)
+  {
+    pResult->cycles = freq.rises - 1;
+    pResult->span = (uint32_t)(freq.lastRise - freq.firstRise);
+    pResult->high = freq.high;
+
+    // Keep the last rising crossing as the start of the next interval
+    MultimeterFreq_rebase(freq.lastRise >> MULTIMETER_FREQ_TIME_FRAC_BITS);
+    freq.rises = 1;
+    freq.firstRise = freq.lastRise;
+    freq.high = 0;
+    freq.samples = 0;
+    freq.bandSamples = 0;
+    freq.minSwing = 0xFFFF;
+
+    return (true);
+  }
+
+  if ((uint32_t)freq.position - (uint32_t)(freq.lastRise >> MULTIMETER_FREQ_TIME_FRAC_BITS) > timeout)
+  {
+    pResult->cycles = 0;
+    pResult->span = 0;
+    pResult->high = 0;
+    pResult->clean = false;
+
+    MultimeterFreq_reset();
+
+    return (true);
+  }
+
+  return (false);
+}
+
+#ifdef MULTIMETER_FREQ_TIMER_CAPTURE
+/*********************************************************************
+ * @fn      MultimeterFreq_openCapture
+ *
+ * @brief   Routes MULTIMETER_FREQ_CAPTURE_PIN to a timer in edge time
+ *          mode, both edges are timed at the 48 MHz system clock.
+ *
+ * @param   None.
+ *
+ * @return  true on success, false otherwise.
+ */
+bool MultimeterFreq_openCapture(void)
+{
+  GPTimerCC26XX_Params params;
+
+  if (captureTimer != NULL)
+  {
+    return (true);
+  }
+
+  capturePin = PIN_open(&capturePinState, capturePinTable);
+  if (capturePin == NULL)
+  {
+    return (false);
+  }
+
+  GPTimerCC26XX_Params_init(&params);
+  params.width = GPT_CONFIG_16BIT;
+  params.mode = GPT_MODE_EDGE_TIME;
+  params.direction = GPTimerCC26XX_DIRECTION_UP;
+  params.debugStallMode = GPTimerCC26XX_DEBUG_STALL_OFF;
+  captureTimer = GPTimerCC26XX_open(MULTIMETER_FREQ_CAPTURE_TIMER, &params);
+  if (captureTimer == NULL)
+  {
+    PIN_close(capturePin);
+    capturePin = NULL;
+    return (false);
+  }
+
+  captureRises = 0;
+  captureSpan = 0;
+  captureHigh = 0;
+
+  PINCC26XX_setMux(capturePin, MULTIMETER_FREQ_CAPTURE_PIN,
+                   GPTimerCC26XX_getPinMux(captureTimer));
+  GPTimerCC26XX_setCaptureEdge(captureTimer, GPTimerCC26XX_BOTH_EDGES);
+  GPTimerCC26XX_setLoadValue(captureTimer, FREQ_CAPTURE_MASK);
+  GPTimerCC26XX_registerInterrupt(captureTimer, MultimeterFreq_captureCB, GPT_INT_CAPTURE);
+  GPTimerCC26XX_start(captureTimer);
+
+  return (true);
+}
+
+/*********************************************************************
+ * @fn      MultimeterFreq_closeCapture
+ *
+ * @brief   Stops the timer capture and releases the timer and the pin.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+void MultimeterFreq_closeCapture(void)
+{
+  if (captureTimer != NULL)
+  {
+    GPTimerCC26XX_stop(captureTimer);
+    GPTimerCC26XX_unregisterInterrupt(captureTimer);
+    GPTimerCC26XX_close(captureTimer);
+    captureTimer = NULL;
+  }
+
+  if (capturePin != NULL)
+  {
+    PIN_close(capturePin);
+    capturePin = NULL;
+  }
+}
+
+/*********************************************************************
+ * @fn      MultimeterFreq_getCapture
+ *
+ * @brief   Ends the timer capture interval once it holds a complete
+ *          cycle. The 24-bit timer wraps after 350 ms, slower signals
+ *          are left to the ADC path.
+ *
+ * @param   pResult - result output.
+ *
+ * @return  true if the interval holds a complete cycle.
+ */
+bool MultimeterFreq_getCapture(multimeterFreqResult_t *pResult)
+{
+  UInt key;
+  bool valid = false;
+
+  key = Hwi_disable();
+  if (captureTimer != NULL && captureRises >= 2)
+  {
+    pResult->cycles = captureRises - 1;
+    pResult->span = captureSpan;
+    pResult->high = captureHigh;
+    pResult->timebase = FREQ_CAPTURE_TIMEBASE;
+    pResult->clean = true;
+
+    captureRises = 1;
+    captureSpan = 0;
+    captureHigh = 0;
+    valid = true;
+  }
+  Hwi_restore(key);
+
+  return (valid);
+}
+#endif // MULTIMETER_FREQ_TIMER_CAPTURE
+
+/*********************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+/*********************************************************************
+ * @fn      MultimeterFreq_interpolate
+ *
+ * @brief   Position of the mid level between two samples on either side
+ *          of it.
+ *
+ * @param   prev - earlier sample.
+ * @param   code - later sample.
+ * @param   mid - mid level.
+ *
+ * @return  Fraction of a sample, MULTIMETER_FREQ_TIME_FRAC_BITS bits.
+ */
+static int32_t MultimeterFreq_interpolate(uint16_t prev, uint16_t code, uint16_t mid)
+{
+  int32_t num = (int32_t)mid - prev;
+  int32_t den = (int32_t)code - prev;
+
+  return ((num << MULTIMETER_FREQ_TIME_FRAC_BITS) / den);
+}
+
+/*********************************************************************
+ * @fn      MultimeterFreq_rebase
+ *
+ * @brief   Moves the time origin to a whole sample.
+ *
+ * @param   origin - new origin in samples since the current one.
+ *
+ * @return  None.
+ */
+static void MultimeterFreq_rebase(int32_t origin)
+{
+  int32_t shift = origin << MULTIMETER_FREQ_TIME_FRAC_BITS;
+
+  freq.position -= origin;
+  freq.midRise -= shift;
+  freq.midFall -= shift;
+  freq.firstRise -= shift;
+  freq.lastRise -= shift;
+}
+
+/*********************************************************************
+ * @fn      MultimeterFreq_track
+ *
+ * @brief   Updates the min / max envelope with the extremes of a window.
+ *          Either side jumps to a new extreme and otherwise decays
+ *          towards the window's extreme with a time constant of
+ *          MULTIMETER_FREQ_ENVELOPE_TIME.
+ *
+ * @param   min - smallest code of the window.
+ * @param   max - largest code of the window.
+ * @param   count - number of samples in the window.
+ * @param   samplingFrequency - ADC sampling frequency in Hz.
+ *
+ * @return  None.
+ */
+static void MultimeterFreq_track(uint16_t min, uint16_t max, uint16_t count,
+                                 uint32_t samplingFrequency)
+{
+  int32_t windowMin = (int32_t)min << FREQ_ENVELOPE_FRAC_BITS;
+  int32_t windowMax = (int32_t)max << FREQ_ENVELOPE_FRAC_BITS;
+  uint32_t timeConstant = (uint32_t)(((uint64_t)samplingFrequency * MULTIMETER_FREQ_ENVELOPE_TIME) / 1000);
+
+  if (!freq.envelopeValid || timeConstant <= count)
+  {
+    freq.envelopeMin = windowMin;
+    freq.envelopeMax = windowMax;
+    freq.envelopeValid = true;
+    return;
+  }
+
+  if (windowMin <= freq.envelopeMin)
+  {
+    freq.envelopeMin = windowMin;
+  }
+  else
+  {
+    freq.envelopeMin += (int32_t)(((uint64_t)(windowMin - freq.envelopeMin) * count) / timeConstant);
+  }
+
+  if (windowMax >= freq.envelopeMax)
+  {
+    freq.envelopeMax = windowMax;
+  }
+  else
+  {
+    freq.envelopeMax -= (int32_t)(((uint64_t)(freq.envelopeMax - windowMax) * count) / timeConstant);
+  }
+}
+
+#ifdef MULTIMETER_FREQ_TIMER_CAPTURE
+/*********************************************************************
+ * @fn      MultimeterFreq_captureCB
+ *
+ * @brief   Timer capture interrupt. The pin level after the edge tells
+ *          a rising from a falling edge.
+ *
+ * @param   handle - timer handle.
+ * @param   interruptMask - interrupts that fired.
+ *
+ * @return  None.
+ */
+static void MultimeterFreq_captureCB(GPTimerCC26XX_Handle handle,
+                                     GPTimerCC26XX_IntMask interruptMask)
+{
+  uint32_t now = GPTimerCC26XX_getValue(handle) & FREQ_CAPTURE_MASK;
+  uint32_t elapsed = (now - captureLastRise) & FREQ_CAPTURE_MASK;
+
+  (void)interruptMask;
+
+  if (PIN_getInputValue(MULTIMETER_FREQ_CAPTURE_PIN))
+  {
+    if (captureRises > 0 && captureSpan < FREQ_CAPTURE_MAX_SPAN)
+    {
+      captureSpan += elapsed;
+      captureHigh += capturePendingHigh;
+      captureRises++;
+    }
+    else if (captureRises == 0)
+    {
+      captureRises = 1;
+    }
+    captureLastRise = now;
+  }
+  else if (captureRises > 0)
+  {
+    capturePendingHigh = elapsed;
+  }
+
+}
+#endif // MULTIMETER_FREQ_TIMER_CAPTURE
+
+/*********************************************************************
+*********************************************************************/
@@ -0,0 +1,198 @@
+/******************************************************************************
+
+ @file  multimeter_freq.h
+
+ @brief This file contains the Multimeter frequency counter definitions
+        and prototypes.
+
+ Group: WCS, BTS
+ Target Device: CC1350
+
+ ******************************************************************************
+
+ Copyright (c) 2013-2017, Texas Instruments Incorporated
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+
+ *  Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+ *  Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+ *  Neither the name of Texas Instruments Incorporated nor the names of
+    its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ Release Name: ti-ble-2.3.2-stack-sdk_1_50_xx
+ Release Date: 2017-09-27 14:52:16
+ *****************************************************************************/
+
+#ifndef MULTIMETER_FREQ_H
+#define MULTIMETER_FREQ_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************************************************************
+ * CONSTANTS
+ */
+
+// Smallest hysteresis around the mid level, in raw ADC codes. Signals
+// with less than four times this swing are not counted.
+#ifndef MULTIMETER_FREQ_MIN_HYSTERESIS
+#define MULTIMETER_FREQ_MIN_HYSTERESIS        8
+#endif
+
+// Hysteresis as a fraction of the peak to peak swing, 1 / 2^shift
+#define MULTIMETER_FREQ_HYSTERESIS_SHIFT      3
+
+// The thresholds are placed again when the envelope's swing changed by
+// more than 1 / 2^shift of the swing they were placed for
+#define MULTIMETER_FREQ_RECENTRE_SHIFT        2
+
+// Smallest swing of a logic level signal, in raw ADC codes (half scale)
+#define MULTIMETER_FREQ_LOGIC_SWING           0x800
+
+// A signal is clean when fewer than 1 / 2^shift of its samples lie
+// between the hysteresis thresholds
+#define MULTIMETER_FREQ_CLEAN_SHIFT           4
+
+// Fractional bits of crossing times in samples
+#define MULTIMETER_FREQ_TIME_FRAC_BITS        8
+
+// Time after which a signal without a complete cycle reads 0 Hz (in msec)
+#define MULTIMETER_FREQ_TIMEOUT               2000
+
+// Time constant of the min / max envelope the thresholds follow (in msec).
+// The envelope has to hold over a whole cycle of the slowest signal that
+// does not time out, one that no longer crosses the thresholds times out.
+#ifndef MULTIMETER_FREQ_ENVELOPE_TIME
+#define MULTIMETER_FREQ_ENVELOPE_TIME         (4 * MULTIMETER_FREQ_TIMEOUT)
+#endif
+
+// Timer capture of a logic level copy of the input. The pin has to be
+// wired to a comparator output or a buffered copy of the input.
+#ifdef MULTIMETER_FREQ_TIMER_CAPTURE
+#ifndef MULTIMETER_FREQ_CAPTURE_PIN
+#define MULTIMETER_FREQ_CAPTURE_PIN           Board_DIO12
+#endif
+#ifndef MULTIMETER_FREQ_CAPTURE_TIMER
+#define MULTIMETER_FREQ_CAPTURE_TIMER         Board_GPTIMER0A
+#endif
+#endif // MULTIMETER_FREQ_TIMER_CAPTURE
+
+/*********************************************************************
+ * TYPEDEFS
+ */
+
+// Complete cycles between the first and the last rising crossing of a
+// measurement interval. Times count periods of a timebase.
+typedef struct
+{
+  uint32_t cycles;        // Complete cycles, 0 if the signal timed out
+  uint32_t span;          // Duration of the cycles
+  uint32_t high;          // Time above the mid level within the cycles
+  uint32_t timebase;      // Timebase frequency in Hz
+  bool     clean;         // The signal is a clean logic level signal
+} multimeterFreqResult_t;
+
+/*********************************************************************
+ * FUNCTIONS
+ */
+
+/*
+ * MultimeterFreq_reset - Drops the crossing history and starts a new
+ *                        measurement interval.
+ */
+extern void MultimeterFreq_reset(void);
+
+/*
+ * MultimeterFreq_process - Feeds raw ADC codes in acquisition order.
+ *
+ *    samples - raw 12-bit ADC codes
+ *    count - number of samples
+ *    samplingFrequency - ADC sampling frequency in Hz
+ */
+extern void MultimeterFreq_process(const uint16_t *samples, uint16_t count,
+                                   uint32_t samplingFrequency);
+
+/*
+ * MultimeterFreq_rollback - Undoes the last MultimeterFreq_process call,
+ *                           for a window whose samples were overwritten
+ *                           while they were read.
+ */
+extern void MultimeterFreq_rollback(void);
+
+/*
+ * MultimeterFreq_get - Ends the measurement interval once it holds a
+ *                      complete cycle or timed out, and starts the next
+ *                      one at its last rising crossing.
+ *
+ *    pResult - result output, times in samples with
+ *              MULTIMETER_FREQ_TIME_FRAC_BITS fractional bits
+ *    samplingFrequency - ADC sampling frequency in Hz
+ *
+ * @return  true if a result was produced
+ */
+extern bool MultimeterFreq_get(multimeterFreqResult_t *pResult,
+                               uint32_t samplingFrequency);
+
+#ifdef MULTIMETER_FREQ_TIMER_CAPTURE
+/*
+ * MultimeterFreq_openCapture - Starts timing the edges on
+ *                              MULTIMETER_FREQ_CAPTURE_PIN.
+ *
+ * @return  true on success
+ */
+extern bool MultimeterFreq_openCapture(void);
+
+/*
+ * MultimeterFreq_closeCapture - Stops the timer capture.
+ */
+extern void MultimeterFreq_closeCapture(void);
+
+/*
+ * MultimeterFreq_getCapture - Ends the timer capture interval like
+ *                             MultimeterFreq_get, times in timer clocks.
+ *
+ *    pResult - result output
+ *
+ * @return  true if the interval holds a complete cycle
+ */
+extern bool MultimeterFreq_getCapture(multimeterFreqResult_t *pResult);
+#endif // MULTIMETER_FREQ_TIMER_CAPTURE
+
+/*********************************************************************
+*********************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MULTIMETER_FREQ_H */
@@ -0,0 +1,279 @@
+/******************************************************************************
+
+ @file  multimeter_histogram.c
+
+ @brief This file contains the Multimeter raw code histogram. Fixed bins
+        of raw ADC codes are counted at the full sample rate over a
+        configurable number of windows, to tell noise from bimodal
+        switching in the readings.
+
+ Group: WCS, BTS
+ Target Device: CC1350
+
+ ******************************************************************************
+
+ Copyright (c) 2013-2017, Texas Instruments Incorporated
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+
+ *  Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+ *  Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+ *  Neither the name of Texas Instruments Incorporated nor the names of
+    its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ Release Name: ti-ble-2.3.2-stack-sdk_1_50_xx
+ Release Date: 2017-09-27 14:52:16
+ *****************************************************************************/
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include "multimeter_histogram.h"
+
+/*********************************************************************
+ * LOCAL VARIABLES
+ */
+
+// Configuration, off by default
+static multimeterHistogramConfig_t histogramConfig = { 0, 0, 1, 0 };
+
+// Counts being accumulated, the extra last bin holds the samples outside
+// the range
+static uint32_t histogramCounts[MULTIMETER_HISTOGRAM_MAX_BINS + 1];
+
+// Windows accumulated so far
+static uint16_t histogramWindows = 0;
+
+// Counts of the window processed last, added by MultimeterHistogram_commit
+// once its samples proved intact. A window holds fewer than 2^16 samples.
+static uint16_t histogramWindowCounts[MULTIMETER_HISTOGRAM_MAX_BINS + 1];
+static bool histogramWindowPending = false;
+
+// Latest complete histogram
+static uint8_t histogramPacked[MULTIMETER_HISTOGRAM_MAX_LEN];
+static uint16_t histogramPackedLen = 0;
+
+/*********************************************************************
+ * LOCAL FUNCTIONS
+ */
+static void MultimeterHistogram_pack(void);
+
+/*********************************************************************
+ * PUBLIC FUNCTIONS
+ */
+
+/*********************************************************************
+ * @fn      MultimeterHistogram_configure
+ *
+ * @brief   Sets the bins and the number of windows and starts a new
+ *          histogram. The previous complete histogram no longer matches
+ *          the bins and is dropped.
+ *
+ * @param   pConfig - new configuration.
+ *
+ * @return  true on success, false otherwise.
+ */
+bool MultimeterHistogram_configure(const multimeterHistogramConfig_t *pConfig)
+{
+  if (pConfig->bins == 0 || pConfig->bins > MULTIMETER_HISTOGRAM_MAX_BINS ||
+      pConfig->widthShift > MULTIMETER_HISTOGRAM_MAX_WIDTH_SHIFT)
+  {
+    return (false);
+  }
+
+  histogramConfig = *pConfig;
+  histogramPackedLen = 0;
+  MultimeterHistogram_restart();
+
+  return (true);
+}
+
+/*********************************************************************
+ * @fn      MultimeterHistogram_getConfig
+ *
+ * @brief   Returns the configuration in use.
+ *
+ * @param   pConfig - configuration output.
+ *
+ * @return  None.
+ */
+void MultimeterHistogram_getConfig(multimeterHistogramConfig_t *pConfig)
+{
+  *pConfig = histogramConfig;
+}
+
+/*********************************************************************
+ * @fn      MultimeterHistogram_restart
+ *
+ * @brief   Drops the histogram being accumulated.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+void MultimeterHistogram_restart(void)
+{
+  uint8_t i;
+
+  for (i = 0; i <= MULTIMETER_HISTOGRAM_MAX_BINS; i++)
+  {
+    histogramCounts[i] = 0;
+  }
+  histogramWindows = 0;
+  histogramWindowPending = false;
+}
+
+/*********************************************************************
+ * @fn      MultimeterHistogram_process
+ *
+ * @brief   Counts the raw codes of a window apart from the histogram
+ *          being accumulated. Codes below the range wrap to large
+ *          offsets, so a single unsigned clamp sends both sides to the
+ *          outside bin and every sample costs one indexed increment.
+ *
+ * @param   samples - raw ADC codes.
+ * @param   count - number of samples.
+ *
+ * @return  None.
+ */
+void MultimeterHistogram_process(const uint16_t *samples, uint16_t count)
+{
+  uint32_t firstCode = histogramConfig.firstCode;
+  uint8_t widthShift = histogramConfig.widthShift;
+  uint32_t bins = histogramConfig.bins;
+  uint32_t bin;
+  uint16_t i;
+
+  if (histogramConfig.windows == 0)
+  {
+    return;
+  }
+
+  for (i = 0; i <= bins; i++)
+  {
+    histogramWindowCounts[i] = 0;
+  }
+
+  for (i = 0; i < count; i++)
+  {
+    bin = ((uint32_t)samples[i] - firstCode) >> widthShift;
+    histogramWindowCounts[(bin < bins) ? bin : bins]++;
+  }
+  histogramWindowPending = true;
+}
+
+/*********************************************************************
+ * @fn      MultimeterHistogram_commit
+ *
+ * @brief   Adds the counts of the window processed last to the histogram
+ *          being accumulated. A window is added at most once.
+ *
+ * @param   None.
+ *
+ * @return  true if the window completed a histogram, false otherwise.
+ */
+bool MultimeterHistogram_commit(void)
+{
+  uint8_t i;
+
+  if (!histogramWindowPending)
+  {
+    return (false);
+  }
+  histogramWindowPending = false;
+
+  for (i = 0; i <= histogramConfig.bins; i++)
+  {
+    histogramCounts[i] += histogramWindowCounts[i];
+  }
+
+  if (++histogramWindows < histogramConfig.windows)
+  {
+    return (false);
+  }
+
+  MultimeterHistogram_pack();
+  MultimeterHistogram_restart();
+
+  return (true);
+}
+
+/*********************************************************************
+ * @fn      MultimeterHistogram_getPacked
+ *
+ * @brief   Returns the latest complete histogram.
+ *
+ * @param   pLen - length output, 0 if no histogram completed yet.
+ *
+ * @return  Packed histogram.
+ */
+const uint8_t *MultimeterHistogram_getPacked(uint16_t *pLen)
+{
+  *pLen = histogramPackedLen;
+
+  return (histogramPacked);
+}
+
+/*********************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+/*********************************************************************
+ * @fn      MultimeterHistogram_pack
+ *
+ * @brief   Packs the accumulated counts behind the configuration header,
+ *          all fields big endian.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+static void MultimeterHistogram_pack(void)
+{
+  uint8_t *p = histogramPacked;
+  uint8_t i;
+
+  p[0] = (uint8_t)(histogramConfig.firstCode >> 8);
+  p[1] = (uint8_t)(histogramConfig.firstCode & 0xFF);
+  p[2] = histogramConfig.widthShift;
+  p[3] = histogramConfig.bins;
+  p[4] = (uint8_t)(histogramWindows >> 8);
+  p[5] = (uint8_t)(histogramWindows & 0xFF);
+  p += MULTIMETER_HISTOGRAM_HEADER_LEN;
+
+  for (i = 0; i <= histogramConfig.bins; i++)
+  {
+    p[0] = (uint8_t)(histogramCounts[i] >> 24);
+    p[1] = (uint8_t)((histogramCounts[i] >> 16) & 0xFF);
+    p[2] = (uint8_t)((histogramCounts[i] >> 8) & 0xFF);
+    p[3] = (uint8_t)(histogramCounts[i] & 0xFF);
+    p += 4;
+  }
+
+  histogramPackedLen = (uint16_t)(p - histogramPacked);
+}
+
+/*********************************************************************
+*********************************************************************/
@@ -0,0 +1,151 @@
+/******************************************************************************
+
+ @file  multimeter_histogram.h
+
+ @brief This file contains the Multimeter raw code histogram definitions
+        and prototypes.
+
+ Group: WCS, BTS
+ Target Device: CC1350
+
+ ******************************************************************************
+
+ Copyright (c) 2013-2017, Texas Instruments Incorporated
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+
+ *  Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+ *  Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+ *  Neither the name of Texas Instruments Incorporated nor the names of
+    its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ Release Name: ti-ble-2.3.2-stack-sdk_1_50_xx
+ Release Date: 2017-09-27 14:52:16
+ *****************************************************************************/
+
+#ifndef MULTIMETER_HISTOGRAM_H
+#define MULTIMETER_HISTOGRAM_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************************************************************
+ * CONSTANTS
+ */
+
+// Largest number of bins, one more counts the samples outside the range
+#define MULTIMETER_HISTOGRAM_MAX_BINS         32
+
+// Largest bin width, as a power of two of raw codes
+#define MULTIMETER_HISTOGRAM_MAX_WIDTH_SHIFT  12
+
+// Packed histogram: a 6 byte header followed by one big endian uint32
+// per bin and one for the samples outside the range
+#define MULTIMETER_HISTOGRAM_HEADER_LEN       6
+#define MULTIMETER_HISTOGRAM_MAX_LEN          (MULTIMETER_HISTOGRAM_HEADER_LEN + \
+                                               (MULTIMETER_HISTOGRAM_MAX_BINS + 1) * 4)
+
+/*********************************************************************
+ * TYPEDEFS
+ */
+
+// Histogram configuration, bin i counts the codes from
+// firstCode + (i << widthShift) up to the next bin
+typedef struct
+{
+  uint16_t firstCode;   // Lowest code of the first bin
+  uint8_t  widthShift;  // Bin width is 2^widthShift codes
+  uint8_t  bins;        // Number of bins
+  uint16_t windows;     // Windows per histogram, 0 turns it off
+} multimeterHistogramConfig_t;
+
+/*********************************************************************
+ * FUNCTIONS
+ */
+
+/*
+ * MultimeterHistogram_configure - Sets the bins and the number of windows
+ *                                 and starts a new histogram.
+ *
+ *    pConfig - new configuration
+ *
+ * @return  true on success, false if a field is out of range
+ */
+extern bool MultimeterHistogram_configure(const multimeterHistogramConfig_t *pConfig);
+
+/*
+ * MultimeterHistogram_getConfig - Returns the configuration in use.
+ *
+ *    pConfig - configuration output
+ */
+extern void MultimeterHistogram_getConfig(multimeterHistogramConfig_t *pConfig);
+
+/*
+ * MultimeterHistogram_restart - Drops the histogram being accumulated, the
+ *                               latest complete one is kept.
+ */
+extern void MultimeterHistogram_restart(void);
+
+/*
+ * MultimeterHistogram_process - Counts the raw codes of a window, held
+ *                               until they are committed.
+ *
+ *    samples - raw ADC codes
+ *    count - number of samples
+ */
+extern void MultimeterHistogram_process(const uint16_t *samples, uint16_t count);
+
+/*
+ * MultimeterHistogram_commit - Adds the window processed last to the
+ *                              histogram, once the window proved intact.
+ *
+ * @return  true if the window completed a histogram
+ */
+extern bool MultimeterHistogram_commit(void);
+
+/*
+ * MultimeterHistogram_getPacked - Returns the latest complete histogram,
+ *                                 packed big endian.
+ *
+ *    pLen - length output, 0 if no histogram completed yet
+ */
+extern const uint8_t *MultimeterHistogram_getPacked(uint16_t *pLen);
+
+/*********************************************************************
+*********************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MULTIMETER_HISTOGRAM_H */
@@ -0,0 +1,190 @@
+/******************************************************************************
+
+ @file  multimeter_ohm.c
+
+ @brief This file contains the Multimeter resistance measurement. The
+        unknown resistor is measured ratiometrically against one of a set
+        of reference resistors a decade apart, selected with the
+        DIO21/DIO22 range switches.
+
+ Group: WCS, BTS
+ Target Device: CC1350
+
+ ******************************************************************************
+
+ Copyright (c) 2013-2017, Texas Instruments Incorporated
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+
+ *  Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+ *  Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+ *  Neither the name of Texas Instruments Incorporated nor the names of
+    its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ Release Name: ti-ble-2.3.2-stack-sdk_1_50_xx
+ Release Date: 2017-09-27 14:52:16
+ *****************************************************************************/
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include "multimeter_ohm.h"
+
+/*********************************************************************
+ * CONSTANTS
+ */
+
+// Fraction of the supply across the unknown resistor, in 1/1000, above
+// which the next higher range is selected and below which the next lower
+// one is. With ranges a decade apart a switch lands near mid scale.
+#define OHM_UP_PER_MILLE                      900
+#define OHM_DOWN_PER_MILLE                    80
+
+// Milliohms per ohm
+#define OHM_MILLI                             1000
+
+/*********************************************************************
+ * LOCAL VARIABLES
+ */
+
+// Reference resistors, indexed by range
+static const uint32_t multimeterOhmRefs[MULTIMETER_OHM_NUM_RANGES] =
+{
+#ifdef MULTIMETER_OHM_REFERENCE_NETWORK
+  MULTIMETER_OHM_REF0_OHM,
+  MULTIMETER_OHM_REF1_OHM,
+  MULTIMETER_OHM_REF2_OHM
+#else
+  MULTIMETER_OHM_REF0_OHM
+#endif // MULTIMETER_OHM_REFERENCE_NETWORK
+};
+
+// Range switch levels, indexed by range
+static const multimeterOhmPins_t multimeterOhmPins[MULTIMETER_OHM_NUM_RANGES] =
+{
+#ifdef MULTIMETER_OHM_REFERENCE_NETWORK
+  { 1, 0 },
+  { 0, 1 },
+  { 1, 1 }
+#else
+  // Neither the shunt nor the divider loads the input
+  { 0, 0 }
+#endif // MULTIMETER_OHM_REFERENCE_NETWORK
+};
+
+/*********************************************************************
+ * PUBLIC FUNCTIONS
+ */
+
+/*********************************************************************
+ * @fn      MultimeterOhm_getPins
+ *
+ * @brief   Returns the range switch levels of a range.
+ *
+ * @param   range - range index.
+ *
+ * @return  Range switch levels.
+ */
+const multimeterOhmPins_t *MultimeterOhm_getPins(uint8_t range)
+{
+  if (range > MULTIMETER_OHM_TOP_RANGE)
+  {
+    range = MULTIMETER_OHM_TOP_RANGE;
+  }
+
+  return (&multimeterOhmPins[range]);
+}
+
+/*********************************************************************
+ * @fn      MultimeterOhm_selectRange
+ *
+ * @brief   Returns the range the next window should be measured on,
+ *          moving one decade at a time towards a mid scale reading.
+ *
+ * @param   range - range of the reading.
+ * @param   microVolt - voltage across the unknown resistor in uV.
+ * @param   supplyMicroVolt - VDDS in uV.
+ *
+ * @return  Range index.
+ */
+uint8_t MultimeterOhm_selectRange(uint8_t range, uint32_t microVolt,
+                                  uint32_t supplyMicroVolt)
+{
+  uint64_t perMille = (uint64_t)microVolt * 1000;
+
+  if (range + 1 < MULTIMETER_OHM_NUM_RANGES &&
+      perMille > (uint64_t)supplyMicroVolt * OHM_UP_PER_MILLE)
+  {
+    return (range + 1);
+  }
+
+  if (range > 0 &&
+      perMille < (uint64_t)supplyMicroVolt * OHM_DOWN_PER_MILLE)
+  {
+    return (range - 1);
+  }
+
+  return (range);
+}
+
+/*********************************************************************
+ * @fn      MultimeterOhm_convert
+ *
+ * @brief   Converts a reading to a resistance. The divider gives
+ *          R = Rref * V / (VDDS - V), a ratio of two voltages, so the
+ *          supply and the ADC gain cancel out.
+ *
+ * @param   range - range of the reading.
+ * @param   microVolt - voltage across the unknown resistor in uV.
+ * @param   supplyMicroVolt - VDDS in uV.
+ * @param   pMilliOhm - resistance output in mOhm.
+ *
+ * @return  true on success, false otherwise.
+ */
+bool MultimeterOhm_convert(uint8_t range, uint32_t microVolt,
+                           uint32_t supplyMicroVolt, uint32_t *pMilliOhm)
+{
+  uint64_t milliOhm;
+  uint32_t drop;
+
+  if (range > MULTIMETER_OHM_TOP_RANGE || microVolt >= supplyMicroVolt)
+  {
+    return (false);
+  }
+
+  drop = supplyMicroVolt - microVolt;
+  milliOhm = ((uint64_t)multimeterOhmRefs[range] * OHM_MILLI * microVolt + drop / 2) / drop;
+  if (milliOhm > 0xFFFFFFFE)
+  {
+    return (false);
+  }
+
+  *pMilliOhm = (uint32_t)milliOhm;
+
+  return (true);
+}
+
+/*********************************************************************
+*********************************************************************/
@@ -0,0 +1,149 @@
+/******************************************************************************
+
+ @file  multimeter_ohm.h
+
+ @brief This file contains the Multimeter resistance measurement
+        definitions and prototypes.
+
+ Group: WCS, BTS
+ Target Device: CC1350
+
+ ******************************************************************************
+
+ Copyright (c) 2013-2017, Texas Instruments Incorporated
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+
+ *  Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+ *  Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+ *  Neither the name of Texas Instruments Incorporated nor the names of
+    its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ Release Name: ti-ble-2.3.2-stack-sdk_1_50_xx
+ Release Date: 2017-09-27 14:52:16
+ *****************************************************************************/
+
+#ifndef MULTIMETER_OHM_H
+#define MULTIMETER_OHM_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************************************************************
+ * CONSTANTS
+ */
+
+// Board configuration. On the stock board DIO21 switches in the 500 mA
+// shunt and DIO22 the 10 V divider, neither selects a reference resistor.
+// Define MULTIMETER_OHM_REFERENCE_NETWORK only on a board with the added
+// network that drives VDDS through MULTIMETER_OHM_REFn_OHM into the ADC
+// input for the DIO21/DIO22 levels of multimeterOhmPins. Without it there
+// is a single range with both lines low, measured against one reference
+// resistor of MULTIMETER_OHM_REF0_OHM from VDDS to the input.
+#ifdef MULTIMETER_OHM_REFERENCE_NETWORK
+#define MULTIMETER_OHM_NUM_RANGES             3
+#else
+#define MULTIMETER_OHM_NUM_RANGES             1
+#endif
+
+// Reference resistors of the ranges in ohms, override them to match the
+// board
+#ifndef MULTIMETER_OHM_REF0_OHM
+#define MULTIMETER_OHM_REF0_OHM               1000
+#endif
+#ifdef MULTIMETER_OHM_REFERENCE_NETWORK
+#ifndef MULTIMETER_OHM_REF1_OHM
+#define MULTIMETER_OHM_REF1_OHM               10000
+#endif
+#ifndef MULTIMETER_OHM_REF2_OHM
+#define MULTIMETER_OHM_REF2_OHM               100000
+#endif
+#endif // MULTIMETER_OHM_REFERENCE_NETWORK
+
+// Highest range, the one a measurement starts on
+#define MULTIMETER_OHM_TOP_RANGE              (MULTIMETER_OHM_NUM_RANGES - 1)
+
+/*********************************************************************
+ * TYPEDEFS
+ */
+
+// Range switch levels
+typedef struct
+{
+  uint8_t dio21;
+  uint8_t dio22;
+} multimeterOhmPins_t;
+
+/*********************************************************************
+ * FUNCTIONS
+ */
+
+/*
+ * MultimeterOhm_getPins - Returns the range switch levels of a range.
+ *
+ *    range - range index
+ */
+extern const multimeterOhmPins_t *MultimeterOhm_getPins(uint8_t range);
+
+/*
+ * MultimeterOhm_selectRange - Returns the range the next window should be
+ *                             measured on.
+ *
+ *    range - range of the reading
+ *    microVolt - voltage across the unknown resistor in uV
+ *    supplyMicroVolt - VDDS in uV
+ */
+extern uint8_t MultimeterOhm_selectRange(uint8_t range, uint32_t microVolt,
+                                         uint32_t supplyMicroVolt);
+
+/*
+ * MultimeterOhm_convert - Converts a reading to a resistance.
+ *
+ *    range - range of the reading
+ *    microVolt - voltage across the unknown resistor in uV
+ *    supplyMicroVolt - VDDS in uV
+ *    pMilliOhm - resistance output in mOhm
+ *
+ * @return  true on success, false on an open or out of range input
+ */
+extern bool MultimeterOhm_convert(uint8_t range, uint32_t microVolt,
+                                  uint32_t supplyMicroVolt, uint32_t *pMilliOhm);
+
+/*********************************************************************
+*********************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MULTIMETER_OHM_H */
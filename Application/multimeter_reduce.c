@@ -0,0 +1,632 @@
+/******************************************************************************
+
+ @file  multimeter_reduce.c
+
+ @brief This file contains the Multimeter window reducers. All reducers work on
+        raw ADC codes in integer arithmetic.
+
+ Group: WCS, BTS
+ Target Device: CC1350
+
+ ******************************************************************************
+
+ Copyright (c) 2013-2017, Texas Instruments Incorporated
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+
+ *  Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+ *  Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+ *  Neither the name of Texas Instruments Incorporated nor the names of
+    its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ Release Name: ti-ble-2.3.2-stack-sdk_1_50_xx
+ Release Date: 2017-09-27 14:52:16
+ *****************************************************************************/
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include <stdbool.h>
+#include <string.h>
+
+#include "multimeter_reduce.h"
+
+/*********************************************************************
+ * CONSTANTS
+ */
+
+// Codes are split into two digits of at most 8 bits, one histogram pass each
+#define REDUCE_MAX_DIGIT_BITS                 ((MULTIMETER_REDUCE_MAX_CODE_BITS + 1) / 2)
+#define REDUCE_MAX_DIGIT_BINS                 (1 << REDUCE_MAX_DIGIT_BITS)
+
+/*********************************************************************
+ * LOCAL VARIABLES
+ */
+
+// Histogram shared by the reducers (kept off the application task stack)
+static uint16_t reduceHistogram[REDUCE_MAX_DIGIT_BINS];
+
+/*********************************************************************
+ * LOCAL FUNCTIONS
+ */
+static uint16_t MultimeterReduce_selectBin(uint16_t *pRank, uint16_t bins);
+static uint16_t MultimeterReduce_selectRank(const uint16_t *samples, uint16_t count,
+                                            uint8_t bits, uint16_t rank,
+                                            bool deviation, uint16_t center);
+
+/*********************************************************************
+ * PUBLIC FUNCTIONS
+ */
+
+/*********************************************************************
+ * @fn      MultimeterReduce_window
+ *
+ * @brief   Radix-select median plus min/max/sum. The first pass
+ *          histograms the upper digit of every code to find the bin
+ *          holding the median and accumulates the other statistics, the
+ *          second pass histograms the lower digit of the codes in that bin
+ *          only. An empty window has all statistics 0.
+ *
+ * @param   samples - ADC codes.
+ * @param   count - number of samples.
+ * @param   bits - resolution of the codes.
+ * @param   pStats - statistics output.
+ *
+ * @return  None.
+ */
+void MultimeterReduce_window(const uint16_t *samples, uint16_t count,
+                             uint8_t bits, multimeterReduceStats_t *pStats)
+{
+  uint8_t lowBits = bits / 2;
+  uint16_t highBins = 1 << (bits - lowBits);
+  uint16_t highMask = highBins - 1;
+  uint16_t lowMask = (1 << lowBits) - 1;
+  uint16_t rank = count / 2;
+  uint16_t minCode = 0xFFFF;
+  uint16_t maxCode = 0;
+  uint32_t sum = 0;
+  uint64_t sumSquares = 0;
+  uint16_t code;
+  uint16_t i;
+  uint16_t high;
+  uint16_t low;
+
+  if (count == 0)
+  {
+    // Nothing to select from, the search would end in the top bin
+    memset(pStats, 0, sizeof(*pStats));
+    return;
+  }
+
+  // Pass 1: upper digit, min, max, sum and sum of squares
+  memset(reduceHistogram, 0, sizeof(reduceHistogram));
+  for (i = 0; i < count; i++)
+  {
+    code = samples[i];
+    reduceHistogram[(code >> lowBits) & highMask]++;
+    sum += code;
+    sumSquares += (uint32_t)code * code;
+    if (code < minCode)
+    {
+      minCode = code;
+    }
+    if (code > maxCode)
+    {
+      maxCode = code;
+    }
+  }
+  high = MultimeterReduce_selectBin(&rank, highBins);
+
+  // Pass 2: lower digit of the codes sharing the selected upper digit
+  memset(reduceHistogram, 0, sizeof(reduceHistogram));
+  for (i = 0; i < count; i++)
+  {
+    if (((samples[i] >> lowBits) & highMask) == high)
+    {
+      reduceHistogram[samples[i] & lowMask]++;
+    }
+  }
+  low = MultimeterReduce_selectBin(&rank, lowMask + 1);
+
+  pStats->median = (uint16_t)((high << lowBits) | low);
+  pStats->min = minCode;
+  pStats->max = maxCode;
+  pStats->count = count;
+  pStats->sum = sum;
+  pStats->variance = (count > 1) ?
+    (uint32_t)((sumSquares - ((uint64_t)sum * sum) / count) / (count - 1)) : 0;
+}
+
+/*********************************************************************
+ * @fn      MultimeterReduce_trimmedMean
+ *
+ * @brief   Trimmed mean in five linear passes. The two cut-off codes are
+ *          found by radix selection, then the codes between them are
+ *          summed together with the share of the ties at either cut-off
+ *          that falls inside the kept ranks.
+ *
+ * @param   samples - ADC codes.
+ * @param   count - number of samples.
+ * @param   bits - resolution of the codes.
+ * @param   trimPercent - percent dropped at either end.
+ *
+ * @return  Mean, MULTIMETER_REDUCE_MEAN_FRAC_BITS fractional bits.
+ */
+uint32_t MultimeterReduce_trimmedMean(const uint16_t *samples, uint16_t count,
+                                      uint8_t bits, uint8_t trimPercent)
+{
+  uint16_t trim;
+  uint16_t kept;
+  uint16_t lowCode;
+  uint16_t highCode;
+  uint16_t belowLow = 0;
+  uint16_t atLow = 0;
+  uint16_t belowHigh = 0;
+  uint64_t sum = 0;
+  uint16_t code;
+  uint16_t i;
+
+  if (count == 0)
+  {
+    return (0);
+  }
+
+  if (trimPercent > MULTIMETER_REDUCE_MAX_TRIM)
+  {
+    trimPercent = MULTIMETER_REDUCE_MAX_TRIM;
+  }
+  trim = (uint16_t)(((uint32_t)count * trimPercent) / 100);
+  kept = count - 2 * trim;
+
+  lowCode = MultimeterReduce_selectRank(samples, count, bits, trim, false, 0);
+  highCode = MultimeterReduce_selectRank(samples, count, bits, count - 1 - trim, false, 0);
+  if (lowCode == highCode)
+  {
+    return ((uint32_t)lowCode << MULTIMETER_REDUCE_MEAN_FRAC_BITS);
+  }
+
+  for (i = 0; i < count; i++)
+  {
+    code = samples[i];
+    if (code < lowCode)
+    {
+      belowLow++;
+      belowHigh++;
+    }
+    else if (code == lowCode)
+    {
+      atLow++;
+      belowHigh++;
+    }
+    else if (code < highCode)
+    {
+      sum += code;
+      belowHigh++;
+    }
+  }
+
+  // Ties at the cut-offs fill the ranks trim to count - 1 - trim
+  sum += (uint64_t)(belowLow + atLow - trim) * lowCode;
+  sum += (uint64_t)(count - trim - belowHigh) * highCode;
+
+  return ((uint32_t)(((sum << MULTIMETER_REDUCE_MEAN_FRAC_BITS) + kept / 2) / kept));
+}
+
+/*********************************************************************
+ * @fn      MultimeterReduce_hampelMean
+ *
+ * @brief   Hampel-filtered mean in three linear passes: the median
+ *          absolute deviation is found by radix selection on the
+ *          distances to the median, the samples within the threshold are
+ *          then averaged. The threshold is at least one code, so a quiet
+ *          window with a MAD of 0 still averages its neighbouring codes.
+ *
+ * @param   samples - ADC codes.
+ * @param   count - number of samples.
+ * @param   bits - resolution of the codes.
+ * @param   median - median of the window.
+ * @param   thresholdTenths - threshold in tenths of a sigma.
+ *
+ * @return  Mean, MULTIMETER_REDUCE_MEAN_FRAC_BITS fractional bits.
+ */
+uint32_t MultimeterReduce_hampelMean(const uint16_t *samples, uint16_t count,
+                                     uint8_t bits, uint16_t median,
+                                     uint8_t thresholdTenths)
+{
+  uint16_t mad;
+  uint32_t limit;
+  uint32_t sum = 0;
+  uint16_t kept = 0;
+  uint16_t distance;
+  uint16_t i;
+
+  if (count == 0)
+  {
+    return (0);
+  }
+
+  if (thresholdTenths < MULTIMETER_REDUCE_MIN_HAMPEL)
+  {
+    thresholdTenths = MULTIMETER_REDUCE_MIN_HAMPEL;
+  }
+
+  // sigma = 1.4826 * MAD
+  mad = MultimeterReduce_selectRank(samples, count, bits, count / 2, true, median);
+  limit = (uint32_t)(((uint64_t)mad * thresholdTenths * 14826 + 50000) / 100000);
+  if (limit < 1)
+  {
+    limit = 1;
+  }
+
+  for (i = 0; i < count; i++)
+  {
+    distance = (samples[i] > median) ? samples[i] - median : median - samples[i];
+    if (distance <= limit)
+    {
+      sum += samples[i];
+      kept++;
+    }
+  }
+
+  // The median itself is always within the limit, kept is at least 1
+  return ((uint32_t)((((uint64_t)sum << MULTIMETER_REDUCE_MEAN_FRAC_BITS) + kept / 2) / kept));
+}
+
+/*********************************************************************
+ * @fn      MultimeterReduce_median
+ *
+ * @brief   Median of a window of raw ADC codes.
+ *
+ * @param   samples - raw ADC codes.
+ * @param   count - number of samples.
+ *
+ * @return  Median code.
+ */
+uint16_t MultimeterReduce_median(const uint16_t *samples, uint16_t count)
+{
+  multimeterReduceStats_t stats;
+
+  MultimeterReduce_window(samples, count, MULTIMETER_REDUCE_CODE_BITS, &stats);
+
+  return (stats.median);
+}
+
+/*********************************************************************
+ * @fn      MultimeterReduce_iir
+ *
+ * @brief   One step of an exponential average. The accumulator keeps
+ *          the average scaled by 2^shift, so no step is truncated away
+ *          and a constant input is reached exactly rather than stalling
+ *          up to 2^shift - 1 below it.
+ *
+ * @param   pAccumulator - average scaled by 2^shift, updated.
+ * @param   valid - false starts the average at the input.
+ * @param   input - new input.
+ * @param   shift - time constant of 2^shift steps.
+ *
+ * @return  Updated average.
+ */
+int32_t MultimeterReduce_iir(int32_t *pAccumulator, bool valid, int32_t input,
+                             uint8_t shift)
+{
+  if (!valid)
+  {
+    *pAccumulator = input * (1 << shift);
+  }
+  else
+  {
+    *pAccumulator += input - (*pAccumulator >> shift);
+  }
+
+  return (*pAccumulator >> shift);
+}
+
+/*********************************************************************
+ * @fn      MultimeterReduce_decimate
+ *
+ * @brief   Boxcar oversample-and-decimate filter in integer arithmetic.
+ *          Summing 4^n samples grows the sum by 2n bits, shifting it down
+ *          by n keeps n extra bits of resolution (the noise acts as
+ *          dither).
+ *
+ * @param   samples - raw ADC codes, overwritten with the decimated codes.
+ * @param   count - number of raw samples.
+ * @param   extraBits - number of extra bits.
+ *
+ * @return  Number of decimated codes.
+ */
+uint16_t MultimeterReduce_decimate(uint16_t *samples, uint16_t count,
+                                   uint8_t extraBits)
+{
+  uint16_t ratio = 1 << (2 * extraBits);
+  uint16_t outputs = count >> (2 * extraBits);
+  const uint16_t *pIn = samples;
+  uint32_t sum;
+  uint16_t i;
+  uint16_t j;
+
+  if (extraBits == 0)
+  {
+    return (count);
+  }
+
+  for (i = 0; i < outputs; i++)
+  {
+    sum = 0;
+    for (j = 0; j < ratio; j++)
+    {
+      sum += *pIn++;
+    }
+    // The output never overtakes the input, so it can be written in place
+    samples[i] = (uint16_t)(sum >> extraBits);
+  }
+
+  return (outputs);
+}
+
+/*********************************************************************
+ * @fn      MultimeterReduce_sumSquares
+ *
+ * @brief   Sum and sum of squares of a window. One load, one add and one
+ *          multiply-accumulate per sample and no branches, a few cycles per
+ *          sample against the 240 cycles between samples at the highest
+ *          ADCBuf rate.
+ *
+ * @param   samples - ADC codes.
+ * @param   count - number of samples.
+ * @param   pSum - sum output.
+ * @param   pSumSquares - sum of squares output.
+ *
+ * @return  None.
+ */
+void MultimeterReduce_sumSquares(const uint16_t *samples, uint16_t count,
+                                 uint32_t *pSum, uint64_t *pSumSquares)
+{
+  const uint16_t *pEnd = samples + count;
+  uint32_t sum = 0;
+  uint64_t sumSquares = 0;
+  uint32_t code;
+
+  while (samples < pEnd)
+  {
+    code = *samples++;
+    sum += code;
+    sumSquares += code * code;
+  }
+
+  *pSum = sum;
+  *pSumSquares = sumSquares;
+}
+
+/*********************************************************************
+ * @fn      MultimeterReduce_rms
+ *
+ * @brief   RMS around a DC level. The sum of (x - dc)^2 is expanded to
+ *          sum(x^2) - 2*dc*sum(x) + count*dc^2, so the samples are not
+ *          needed again. All terms stay below 2^51 for 16-bit codes.
+ *
+ * @param   sum - sum of the codes.
+ * @param   sumSquares - sum of the squared codes.
+ * @param   count - number of samples.
+ * @param   dc - DC level, fracBits fractional bits.
+ * @param   fracBits - fractional bits of dc and of the result.
+ *
+ * @return  RMS, fracBits fractional bits.
+ */
+uint32_t MultimeterReduce_rms(uint32_t sum, uint64_t sumSquares, uint16_t count,
+                              uint32_t dc, uint8_t fracBits)
+{
+  int64_t acc;
+
+  if (count == 0)
+  {
+    return (0);
+  }
+
+  acc = (int64_t)(sumSquares << (2 * fracBits)) -
+        2 * (int64_t)dc * ((int64_t)sum << fracBits) +
+        (int64_t)count * dc * dc;
+
+  if (acc <= 0)
+  {
+    return (0);
+  }
+
+  return (MultimeterReduce_sqrt((uint64_t)acc / count));
+}
+
+/*********************************************************************
+ * @fn      MultimeterReduce_sqrt
+ *
+ * @brief   Integer square root, one result bit per iteration.
+ *
+ * @param   value - radicand.
+ *
+ * @return  floor(sqrt(value)).
+ */
+uint32_t MultimeterReduce_sqrt(uint64_t value)
+{
+  uint64_t bit = (uint64_t)1 << 62;
+  uint64_t result = 0;
+
+  while (bit > value)
+  {
+    bit >>= 2;
+  }
+
+  while (bit != 0)
+  {
+    if (value >= result + bit)
+    {
+      value -= result + bit;
+      result = (result >> 1) + bit;
+    }
+    else
+    {
+      result >>= 1;
+    }
+    bit >>= 2;
+  }
+
+  return ((uint32_t)result);
+}
+
+/*********************************************************************
+ * @fn      MultimeterReduce_tonePower
+ *
+ * @brief   Goertzel detector. The second order resonator runs on the
+ *          mean-free codes in 32 bits; with at most 1024 samples of 16 bits
+ *          the state cannot overflow.
+ *
+ * @param   samples - ADC codes.
+ * @param   count - number of samples.
+ * @param   coeff - 2*cos(2*pi*f/fs), MULTIMETER_REDUCE_TONE_SHIFT
+ *                  fractional bits.
+ *
+ * @return  Power of the tone, amplitude^2 * count^2 / 4 in squared codes.
+ */
+uint64_t MultimeterReduce_tonePower(const uint16_t *samples, uint16_t count,
+                                    int32_t coeff)
+{
+  uint32_t sum = 0;
+  int32_t mean;
+  int32_t s0;
+  int32_t s1 = 0;
+  int32_t s2 = 0;
+  uint16_t i;
+
+  if (count == 0)
+  {
+    return (0);
+  }
+
+  for (i = 0; i < count; i++)
+  {
+    sum += samples[i];
+  }
+  mean = (int32_t)((sum + count / 2) / count);
+
+  for (i = 0; i < count; i++)
+  {
+    s0 = ((int32_t)samples[i] - mean) +
+         (int32_t)(((int64_t)coeff * s1) >> MULTIMETER_REDUCE_TONE_SHIFT) - s2;
+    s2 = s1;
+    s1 = s0;
+  }
+
+  return ((uint64_t)((int64_t)s1 * s1 + (int64_t)s2 * s2 -
+          (int64_t)(((int64_t)coeff * s1) >> MULTIMETER_REDUCE_TONE_SHIFT) * s2));
+}
+
+/*********************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+/*********************************************************************
+ * @fn      MultimeterReduce_selectBin
+ *
+ * @brief   Finds the histogram bin holding the element of the given rank.
+ *
+ * @param   pRank - in: rank to look for, out: rank within the found bin.
+ * @param   bins - number of histogram bins in use.
+ *
+ * @return  Bin index.
+ */
+static uint16_t MultimeterReduce_selectBin(uint16_t *pRank, uint16_t bins)
+{
+  uint16_t bin;
+
+  for (bin = 0; bin < bins - 1; bin++)
+  {
+    if (*pRank < reduceHistogram[bin])
+    {
+      break;
+    }
+    *pRank -= reduceHistogram[bin];
+  }
+
+  return (bin);
+}
+
+/*********************************************************************
+ * @fn      MultimeterReduce_selectRank
+ *
+ * @brief   Radix selection of the code of a given rank, on the codes
+ *          themselves or on their distances to a center.
+ *
+ * @param   samples - ADC codes.
+ * @param   count - number of samples.
+ * @param   bits - resolution of the codes.
+ * @param   rank - rank to select, 0 is the smallest.
+ * @param   deviation - select on |code - center| instead of code.
+ * @param   center - center of the distances.
+ *
+ * @return  Code or distance of the given rank.
+ */
+static uint16_t MultimeterReduce_selectRank(const uint16_t *samples, uint16_t count,
+                                            uint8_t bits, uint16_t rank,
+                                            bool deviation, uint16_t center)
+{
+  uint8_t lowBits = bits / 2;
+  uint16_t highBins = 1 << (bits - lowBits);
+  uint16_t highMask = highBins - 1;
+  uint16_t lowMask = (1 << lowBits) - 1;
+  uint16_t value;
+  uint16_t high;
+  uint16_t low;
+  uint16_t i;
+
+  memset(reduceHistogram, 0, sizeof(reduceHistogram));
+  for (i = 0; i < count; i++)
+  {
+    value = samples[i];
+    if (deviation)
+    {
+      value = (value > center) ? value - center : center - value;
+    }
+    reduceHistogram[(value >> lowBits) & highMask]++;
+  }
+  high = MultimeterReduce_selectBin(&rank, highBins);
+
+  memset(reduceHistogram, 0, sizeof(reduceHistogram));
+  for (i = 0; i < count; i++)
+  {
+    value = samples[i];
+    if (deviation)
+    {
+      value = (value > center) ? value - center : center - value;
+    }
+    if (((value >> lowBits) & highMask) == high)
+    {
+      reduceHistogram[value & lowMask]++;
+    }
+  }
+  low = MultimeterReduce_selectBin(&rank, lowMask + 1);
+
+  return ((uint16_t)((high << lowBits) | low));
+}
+
+/*********************************************************************
+*********************************************************************/
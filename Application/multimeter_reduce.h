@@ -0,0 +1,273 @@
+/******************************************************************************
+
+ @file  multimeter_reduce.h
+
+ @brief This file contains the Multimeter window reducer definitions and
+        prototypes.
+
+ Group: WCS, BTS
+ Target Device: CC1350
+
+ ******************************************************************************
+
+ Copyright (c) 2013-2017, Texas Instruments Incorporated
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+
+ *  Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+ *  Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+ *  Neither the name of Texas Instruments Incorporated nor the names of
+    its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ Release Name: ti-ble-2.3.2-stack-sdk_1_50_xx
+ Release Date: 2017-09-27 14:52:16
+ *****************************************************************************/
+
+#ifndef MULTIMETER_REDUCE_H
+#define MULTIMETER_REDUCE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************************************************************
+ * CONSTANTS
+ */
+
+// Resolution of the raw ADC codes
+#define MULTIMETER_REDUCE_CODE_BITS           12
+
+// Highest resolution handled by the reducers (oversampled codes)
+#define MULTIMETER_REDUCE_MAX_CODE_BITS       16
+
+// Largest supported number of oversampling bits, 4^4 = 256 samples per output
+#define MULTIMETER_REDUCE_MAX_OVERSAMPLING    (MULTIMETER_REDUCE_MAX_CODE_BITS - MULTIMETER_REDUCE_CODE_BITS)
+
+// Fractional bits of the tone detector coefficient
+#define MULTIMETER_REDUCE_TONE_SHIFT          14
+
+// Fractional bits of the trimmed and Hampel-filtered means
+#define MULTIMETER_REDUCE_MEAN_FRAC_BITS      4
+
+// Parameter ranges and defaults of the reducers, see MultimeterReduceType
+#define MULTIMETER_REDUCE_MAX_TRIM            49
+#define MULTIMETER_REDUCE_DEFAULT_TRIM        25
+#define MULTIMETER_REDUCE_MIN_HAMPEL          1
+#define MULTIMETER_REDUCE_DEFAULT_HAMPEL      30
+#define MULTIMETER_REDUCE_MAX_IIR_SHIFT       8
+#define MULTIMETER_REDUCE_DEFAULT_IIR_SHIFT   3
+
+/*********************************************************************
+ * TYPEDEFS
+ */
+
+/*!
+ *  @def    MultimeterReduceType
+ *  @brief  Enum of the reducers turning a window into a reading, with the
+ *          meaning of their parameter
+ */
+typedef enum MultimeterReduceType {
+    MultimeterReduceType_Median = 0,    // No parameter
+    MultimeterReduceType_TrimmedMean,   // Percent dropped at either end, 0 to 49
+    MultimeterReduceType_Hampel,        // Outlier threshold in tenths of a sigma
+    MultimeterReduceType_Iir,           // Time constant, 2^n windows, 0 to 8
+
+    MultimeterReduceType_Count
+} MultimeterReduceType;
+
+// Statistics of one window, all in raw ADC codes
+typedef struct
+{
+  uint16_t median;  // Element at index count/2 once sorted
+  uint16_t min;     // Smallest code
+  uint16_t max;     // Largest code
+  uint16_t count;   // Number of samples
+  uint32_t sum;     // Sum of all codes, sum/count is the mean
+  uint32_t variance; // Sample variance in squared codes
+} multimeterReduceStats_t;
+
+/*********************************************************************
+ * FUNCTIONS
+ */
+
+/*
+ * MultimeterReduce_window - Computes the statistics of a window of ADC
+ *                           codes in two linear passes. The window is left
+ *                           untouched. An empty window has all statistics
+ *                           0.
+ *
+ *    samples - ADC codes
+ *    count - number of samples, 0 to 65535
+ *    bits - resolution of the codes, MULTIMETER_REDUCE_CODE_BITS to
+ *           MULTIMETER_REDUCE_MAX_CODE_BITS
+ *    pStats - statistics output
+ */
+extern void MultimeterReduce_window(const uint16_t *samples, uint16_t count,
+                                    uint8_t bits, multimeterReduceStats_t *pStats);
+
+/*
+ * MultimeterReduce_decimate - Oversample-and-decimate filter. Every group of
+ *                             4^extraBits raw codes is summed and shifted
+ *                             down by extraBits, giving codes with
+ *                             extraBits more resolution. The outputs are
+ *                             written in place at the start of the window.
+ *
+ *    samples - raw 12-bit ADC codes, overwritten with the decimated codes
+ *    count - number of raw samples
+ *    extraBits - 0 to MULTIMETER_REDUCE_MAX_OVERSAMPLING
+ *
+ * @return  number of decimated codes (count / 4^extraBits)
+ */
+extern uint16_t MultimeterReduce_decimate(uint16_t *samples, uint16_t count,
+                                          uint8_t extraBits);
+
+/*
+ * MultimeterReduce_sumSquares - Sum and sum of squares of a window in a
+ *                               single pass, the kernel of the true RMS
+ *                               measurement.
+ *
+ *    samples - ADC codes
+ *    count - number of samples
+ *    pSum - sum output
+ *    pSumSquares - sum of squares output
+ */
+extern void MultimeterReduce_sumSquares(const uint16_t *samples, uint16_t count,
+                                        uint32_t *pSum, uint64_t *pSumSquares);
+
+/*
+ * MultimeterReduce_rms - RMS of a window around a given DC level, from its
+ *                        sum and sum of squares.
+ *
+ *    sum - sum of the codes
+ *    sumSquares - sum of the squared codes
+ *    count - number of samples
+ *    dc - DC level with fracBits fractional bits
+ *    fracBits - fractional bits of dc and of the result, at most 8
+ *
+ * @return  RMS with fracBits fractional bits
+ */
+extern uint32_t MultimeterReduce_rms(uint32_t sum, uint64_t sumSquares, uint16_t count,
+                                     uint32_t dc, uint8_t fracBits);
+
+/*
+ * MultimeterReduce_sqrt - Integer square root.
+ *
+ *    value - radicand
+ *
+ * @return  floor(sqrt(value))
+ */
+extern uint32_t MultimeterReduce_sqrt(uint64_t value);
+
+/*
+ * MultimeterReduce_tonePower - Goertzel detector, power of a single
+ *                              frequency in a window after removing its
+ *                              mean. Only relative values are meaningful.
+ *
+ *    samples - ADC codes
+ *    count - number of samples, at most 1024
+ *    coeff - 2*cos(2*pi*f/fs) with MULTIMETER_REDUCE_TONE_SHIFT fractional
+ *            bits
+ */
+extern uint64_t MultimeterReduce_tonePower(const uint16_t *samples, uint16_t count,
+                                           int32_t coeff);
+
+/*
+ * MultimeterReduce_trimmedMean - Mean of a window without the lowest and
+ *                                highest trimPercent of its samples.
+ *
+ *    samples - ADC codes
+ *    count - number of samples, 0 to 65535 (0 gives 0)
+ *    bits - resolution of the codes
+ *    trimPercent - percent dropped at either end, 0 to
+ *                  MULTIMETER_REDUCE_MAX_TRIM
+ *
+ * @return  mean with MULTIMETER_REDUCE_MEAN_FRAC_BITS fractional bits
+ */
+extern uint32_t MultimeterReduce_trimmedMean(const uint16_t *samples, uint16_t count,
+                                             uint8_t bits, uint8_t trimPercent);
+
+/*
+ * MultimeterReduce_hampelMean - Mean of the samples of a window within a
+ *                               threshold of its median, the threshold in
+ *                               units of the median absolute deviation
+ *                               scaled to a sigma (1.4826 MAD).
+ *
+ *    samples - ADC codes
+ *    count - number of samples, 0 to 65535 (0 gives 0)
+ *    bits - resolution of the codes
+ *    median - median of the window
+ *    thresholdTenths - threshold in tenths of a sigma, at least
+ *                      MULTIMETER_REDUCE_MIN_HAMPEL
+ *
+ * @return  mean with MULTIMETER_REDUCE_MEAN_FRAC_BITS fractional bits
+ */
+extern uint32_t MultimeterReduce_hampelMean(const uint16_t *samples, uint16_t count,
+                                            uint8_t bits, uint16_t median,
+                                            uint8_t thresholdTenths);
+
+/*
+ * MultimeterReduce_median - Returns the median of a window of raw ADC codes
+ *                           (the element at index count/2 once sorted).
+ *                           Runs in two histogram passes, so the cost is
+ *                           linear in count and the window is left
+ *                           untouched.
+ *
+ *    samples - raw 12-bit ADC codes
+ *    count - number of samples, 0 to 65535 (0 gives 0)
+ */
+extern uint16_t MultimeterReduce_median(const uint16_t *samples, uint16_t count);
+
+/*
+ * MultimeterReduce_iir - One step of an exponential average, the IIR
+ *                        reducer across windows.
+ *
+ *    pAccumulator - average scaled by 2^shift, kept by the caller across
+ *                   steps with the same shift. input * 2^shift must fit
+ *                   in int32_t.
+ *    valid - false starts the average at the input
+ *    input - new input
+ *    shift - time constant of 2^shift steps, 0 to
+ *            MULTIMETER_REDUCE_MAX_IIR_SHIFT
+ *
+ * @return  updated average, same fractional bits as the input
+ */
+extern int32_t MultimeterReduce_iir(int32_t *pAccumulator, bool valid, int32_t input,
+                                    uint8_t shift);
+
+/*********************************************************************
+*********************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MULTIMETER_REDUCE_H */
@@ -0,0 +1,228 @@
+/******************************************************************************
+
+ @file  multimeter_ring.c
+
+ @brief This file contains the lock-free ring handing completed
+        acquisition windows from the ADC driver callback to the
+        application task. It does not depend on the driver.
+
+ Group: WCS, BTS
+ Target Device: CC1350
+
+ ******************************************************************************
+
+ Copyright (c) 2013-2017, Texas Instruments Incorporated
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+
+ *  Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+ *  Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+ *  Neither the name of Texas Instruments Incorporated nor the names of
+    its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ Release Name: ti-ble-2.3.2-stack-sdk_1_50_xx
+ Release Date: 2017-09-27 14:52:16
+ *****************************************************************************/
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include "multimeter_ring.h"
+
+/*********************************************************************
+ * LOCAL VARIABLES
+ */
+
+// Single producer (driver callback), single consumer (application task)
+// ring of window descriptors. The head is only written by the producer and
+// the tail only by the consumer, so no lock is needed.
+static volatile multimeterAcqWindow_t ringSlots[MULTIMETER_ACQ_RING_SIZE];
+static volatile uint8_t ringHead = 0;
+static volatile uint8_t ringTail = 0;
+
+// Incremented every time the driver starts refilling a buffer
+static volatile uint32_t ringGeneration[MULTIMETER_RING_NUM_BUFFERS];
+
+// Each counter has a single writer, the producer can pre-empt the consumer
+// in the middle of an increment
+static volatile uint32_t ringOverrunCount = 0;    // Consumer
+static volatile uint32_t ringLostCount = 0;       // Producer
+static volatile uint32_t ringOverflowCount = 0;   // Producer
+
+/*********************************************************************
+ * PUBLIC FUNCTIONS
+ */
+
+/*********************************************************************
+ * @fn      MultimeterRing_put
+ *
+ * @brief   Producer side of the ring. The driver moves on to the other
+ *          buffer once a window completes, so its generation is bumped
+ *          before the window is published.
+ *
+ * @param   pWindow - completed window.
+ *
+ * @return  None.
+ */
+void MultimeterRing_put(const multimeterAcqWindow_t *pWindow)
+{
+  volatile multimeterAcqWindow_t *pSlot;
+  uint8_t head = ringHead;
+  uint8_t buffer = pWindow->buffer;
+
+  ringGeneration[buffer ^ 1]++;
+  MULTIMETER_RING_BARRIER();
+
+  if ((uint8_t)(head - ringTail) >= MULTIMETER_ACQ_RING_SIZE)
+  {
+    ringOverflowCount++;
+    return;
+  }
+
+  pSlot = &ringSlots[head & (MULTIMETER_ACQ_RING_SIZE - 1)];
+  *pSlot = *pWindow;
+  pSlot->generation = ringGeneration[buffer];
+
+  // Slot filled, publish it to the consumer
+  MULTIMETER_RING_BARRIER();
+  ringHead = head + 1;
+}
+
+/*********************************************************************
+ * @fn      MultimeterRing_countLost
+ *
+ * @brief   Producer side, counts a window lost before completion.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+void MultimeterRing_countLost(void)
+{
+  ringLostCount++;
+}
+
+/*********************************************************************
+ * @fn      MultimeterRing_get
+ *
+ * @brief   Consumer side of the ring. Only the descriptor is copied, the
+ *          samples are read in place.
+ *
+ * @param   pWindow - window output.
+ *
+ * @return  true if a window was taken, false otherwise.
+ */
+bool MultimeterRing_get(multimeterAcqWindow_t *pWindow)
+{
+  uint8_t tail;
+
+  while ((tail = ringTail) != ringHead)
+  {
+    MULTIMETER_RING_BARRIER();
+    *pWindow = ringSlots[tail & (MULTIMETER_ACQ_RING_SIZE - 1)];
+
+    // Slot copied, hand it back to the producer
+    MULTIMETER_RING_BARRIER();
+    ringTail = tail + 1;
+
+    if (pWindow->generation == ringGeneration[pWindow->buffer])
+    {
+      return (true);
+    }
+
+    ringOverrunCount++;
+  }
+
+  return (false);
+}
+
+/*********************************************************************
+ * @fn      MultimeterRing_release
+ *
+ * @brief   Consumer side, checks the samples of a window were intact
+ *          until now. The driver never waits for the application.
+ *
+ * @param   pWindow - window taken by MultimeterRing_get.
+ *
+ * @return  true if the samples were intact, false otherwise.
+ */
+bool MultimeterRing_release(const multimeterAcqWindow_t *pWindow)
+{
+  // The samples have been read before the generation is
+  MULTIMETER_RING_BARRIER();
+
+  if (pWindow->generation != ringGeneration[pWindow->buffer])
+  {
+    ringOverrunCount++;
+    return (false);
+  }
+
+  return (true);
+}
+
+/*********************************************************************
+ * @fn      MultimeterRing_flush
+ *
+ * @brief   Consumer side, drops the queued windows.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+void MultimeterRing_flush(void)
+{
+  ringTail = ringHead;
+}
+
+/*********************************************************************
+ * @fn      MultimeterRing_getOverrunCount
+ *
+ * @brief   Returns the number of lost or overwritten windows.
+ *
+ * @param   None.
+ *
+ * @return  Overrun count.
+ */
+uint32_t MultimeterRing_getOverrunCount(void)
+{
+  return (ringOverrunCount + ringLostCount);
+}
+
+/*********************************************************************
+ * @fn      MultimeterRing_getOverflowCount
+ *
+ * @brief   Returns the number of windows dropped on a full ring.
+ *
+ * @param   None.
+ *
+ * @return  Overflow count.
+ */
+uint32_t MultimeterRing_getOverflowCount(void)
+{
+  return (ringOverflowCount);
+}
+
+/*********************************************************************
+*********************************************************************/
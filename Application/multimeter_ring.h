@@ -0,0 +1,149 @@
+/******************************************************************************
+
+ @file  multimeter_ring.h
+
+ @brief This file contains the Multimeter window ring definitions
+        and prototypes.
+
+ Group: WCS, BTS
+ Target Device: CC1350
+
+ ******************************************************************************
+
+ Copyright (c) 2013-2017, Texas Instruments Incorporated
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+
+ *  Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+ *  Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+ *  Neither the name of Texas Instruments Incorporated nor the names of
+    its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ Release Name: ti-ble-2.3.2-stack-sdk_1_50_xx
+ Release Date: 2017-09-27 14:52:16
+ *****************************************************************************/
+
+#ifndef MULTIMETER_RING_H
+#define MULTIMETER_RING_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "multimeter_acq.h"
+
+/*********************************************************************
+ * CONSTANTS
+ */
+
+// Number of sample buffers the driver alternates between
+#define MULTIMETER_RING_NUM_BUFFERS           2
+
+/*********************************************************************
+ * MACROS
+ */
+
+// Memory barrier between the producer and the consumer. Both run on the
+// same core on the target, where the volatile accesses are enough; a
+// multi-core host defines it to a full barrier.
+#ifndef MULTIMETER_RING_BARRIER
+#define MULTIMETER_RING_BARRIER()
+#endif
+
+/*********************************************************************
+ * FUNCTIONS
+ */
+
+/*
+ * MultimeterRing_put - Producer side. Marks the other buffer as being
+ *                      refilled, which invalidates any window still
+ *                      queued or held in it, and queues the window. A full
+ *                      ring drops the window and counts an overflow.
+ *
+ *    pWindow - completed window, its generation is filled in
+ */
+extern void MultimeterRing_put(const multimeterAcqWindow_t *pWindow);
+
+/*
+ * MultimeterRing_countLost - Producer side. Counts a window the producer
+ *                            lost before it was completed as an overrun.
+ */
+extern void MultimeterRing_countLost(void);
+
+/*
+ * MultimeterRing_get - Consumer side. Takes the oldest queued window,
+ *                      windows whose buffer has been refilled since are
+ *                      skipped and counted as overruns.
+ *
+ *    pWindow - window output
+ *
+ * @return  true if a window was taken, false if the ring is empty
+ */
+extern bool MultimeterRing_get(multimeterAcqWindow_t *pWindow);
+
+/*
+ * MultimeterRing_release - Consumer side. Checks that the buffer of a
+ *                          window was not refilled while it was read.
+ *
+ *    pWindow - window taken by MultimeterRing_get
+ *
+ * @return  true if the samples were intact, false (and an overrun
+ *          counted) otherwise
+ */
+extern bool MultimeterRing_release(const multimeterAcqWindow_t *pWindow);
+
+/*
+ * MultimeterRing_flush - Consumer side. Drops the queued windows, the
+ *                        producer must be stopped.
+ */
+extern void MultimeterRing_flush(void);
+
+/*
+ * MultimeterRing_getOverrunCount - Returns the number of windows lost or
+ *                                  overwritten before they were used.
+ */
+extern uint32_t MultimeterRing_getOverrunCount(void);
+
+/*
+ * MultimeterRing_getOverflowCount - Returns the number of windows dropped
+ *                                   on a full ring.
+ */
+extern uint32_t MultimeterRing_getOverflowCount(void);
+
+/*********************************************************************
+*********************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MULTIMETER_RING_H */
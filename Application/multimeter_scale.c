@@ -0,0 +1,140 @@
+/******************************************************************************
+
+ @file  multimeter_scale.c
+
+ @brief This file contains the Multimeter fixed-point range scaling. The gain
+        table is generated by the compiler from the calibration constants in
+        multimeter_scale.h, so no floating point is used at run time.
+
+ Group: WCS, BTS
+ Target Device: CC1350
+
+ ******************************************************************************
+
+ Copyright (c) 2013-2017, Texas Instruments Incorporated
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+
+ *  Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+ *  Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+ *  Neither the name of Texas Instruments Incorporated nor the names of
+    its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ Release Name: ti-ble-2.3.2-stack-sdk_1_50_xx
+ Release Date: 2017-09-27 14:52:16
+ *****************************************************************************/
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include "multimeter_scale.h"
+#include "multimeter_cal.h"
+
+/*********************************************************************
+ * CONSTANTS
+ */
+
+// Rounding term for the gain multiplication
+#define SCALE_ROUND                           (1UL << (MULTIMETER_SCALE_GAIN_SHIFT - 1))
+
+/*********************************************************************
+ * LOCAL VARIABLES
+ */
+
+// Per-range conversion, indexed by MultimeterMode
+static const multimeterScale_t multimeterScaleTable[MultimeterMode_Count] =
+{
+  // MultimeterMode_Off
+  { MULTIMETER_SCALE_GAIN(1, 1), 0 },
+
+  // MultimeterMode_3V
+  { MULTIMETER_SCALE_GAIN(1, 1), 0 },
+
+  // MultimeterMode_10V
+  { MULTIMETER_SCALE_GAIN(MULTIMETER_CAL_10V_NUM, MULTIMETER_CAL_10V_DEN),
+    MULTIMETER_CAL_10V_OFFSET },
+
+  // MultimeterMode_500mA
+  { MULTIMETER_SCALE_GAIN(MULTIMETER_CAL_500MA_NUM, MULTIMETER_CAL_500MA_DEN),
+    MULTIMETER_CAL_500MA_OFFSET },
+
+  // MultimeterMode_Ohm, the resistance is computed from the ADC voltage
+  { MULTIMETER_SCALE_GAIN(1, 1), 0 },
+
+  // MultimeterMode_10VAC, RMS of the AC part, the offset cancels out
+  { MULTIMETER_SCALE_GAIN(MULTIMETER_CAL_10V_NUM, MULTIMETER_CAL_10V_DEN), 0 },
+
+  // MultimeterMode_500mAAC
+  { MULTIMETER_SCALE_GAIN(MULTIMETER_CAL_500MA_NUM, MULTIMETER_CAL_500MA_DEN), 0 },
+
+  // MultimeterMode_Frequency, MultimeterMode_Period and
+  // MultimeterMode_DutyCycle measure on the 3V input
+  { MULTIMETER_SCALE_GAIN(1, 1), 0 },
+  { MULTIMETER_SCALE_GAIN(1, 1), 0 },
+  { MULTIMETER_SCALE_GAIN(1, 1), 0 },
+
+  // MultimeterMode_AutoV, readings use the range currently selected
+  { MULTIMETER_SCALE_GAIN(1, 1), 0 },
+
+  // MultimeterMode_Continuity and MultimeterMode_Diode measure the ADC
+  // voltage across the device under test
+  { MULTIMETER_SCALE_GAIN(1, 1), 0 },
+  { MULTIMETER_SCALE_GAIN(1, 1), 0 },
+};
+
+/*********************************************************************
+ * PUBLIC FUNCTIONS
+ */
+
+/*********************************************************************
+ * @fn      MultimeterScale_apply
+ *
+ * @brief   Converts an ADC input voltage to the reading of a range. The
+ *          32x32 bit multiplication maps to a single UMULL on the M3. The
+ *          nominal reading is then corrected by the range's calibration
+ *          table, if any.
+ *
+ * @param   mode - multimeter range.
+ * @param   microVolt - voltage at the ADC input in uV.
+ *
+ * @return  Reading in the range's unit (uV or uA).
+ */
+int32_t MultimeterScale_apply(MultimeterMode mode, uint32_t microVolt)
+{
+  const multimeterScale_t *pScale;
+
+  if (mode >= MultimeterMode_Count)
+  {
+    mode = MultimeterMode_3V;
+  }
+  pScale = &multimeterScaleTable[mode];
+
+  return (MultimeterCal_apply(mode,
+                              (int32_t)((((uint64_t)microVolt * pScale->gain) + SCALE_ROUND) >>
+                                        MULTIMETER_SCALE_GAIN_SHIFT) + pScale->offset));
+}
+
+/*********************************************************************
+*********************************************************************/
@@ -0,0 +1,135 @@
+/******************************************************************************
+
+ @file  multimeter_scale.h
+
+ @brief This file contains the Multimeter fixed-point range scaling definitions
+        and prototypes.
+
+ Group: WCS, BTS
+ Target Device: CC1350
+
+ ******************************************************************************
+
+ Copyright (c) 2013-2017, Texas Instruments Incorporated
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+
+ *  Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+ *  Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+ *  Neither the name of Texas Instruments Incorporated nor the names of
+    its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ Release Name: ti-ble-2.3.2-stack-sdk_1_50_xx
+ Release Date: 2017-09-27 14:52:16
+ *****************************************************************************/
+
+#ifndef MULTIMETER_SCALE_H
+#define MULTIMETER_SCALE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include <stdint.h>
+
+#include "bcomdef.h"
+#include "../profiles/multimeter_gatt_profile.h"
+
+/*********************************************************************
+ * CONSTANTS
+ */
+
+// Calibration constants of the front end. Each range divides the ADC input
+// voltage (uV) by NUM/DEN and then adds OFFSET to get the reading.
+
+// 10V range: 0.3 voltage divider
+#ifndef MULTIMETER_CAL_10V_NUM
+#define MULTIMETER_CAL_10V_NUM                3
+#endif
+#ifndef MULTIMETER_CAL_10V_DEN
+#define MULTIMETER_CAL_10V_DEN                10
+#endif
+#ifndef MULTIMETER_CAL_10V_OFFSET
+#define MULTIMETER_CAL_10V_OFFSET             0
+#endif
+
+// 500mA range: 6.85 uV/uA shunt amplifier, -1200 uA offset
+#ifndef MULTIMETER_CAL_500MA_NUM
+#define MULTIMETER_CAL_500MA_NUM              685
+#endif
+#ifndef MULTIMETER_CAL_500MA_DEN
+#define MULTIMETER_CAL_500MA_DEN              100
+#endif
+#ifndef MULTIMETER_CAL_500MA_OFFSET
+#define MULTIMETER_CAL_500MA_OFFSET           (-1200)
+#endif
+
+// Fractional bits of the scaling gains
+#define MULTIMETER_SCALE_GAIN_SHIFT           20
+
+/*********************************************************************
+ * MACROS
+ */
+
+// Rounded fixed-point gain DEN/NUM, evaluated by the compiler
+#define MULTIMETER_SCALE_GAIN(num, den) \
+  ((uint32_t)((((uint64_t)(den) << MULTIMETER_SCALE_GAIN_SHIFT) + ((num) / 2)) / (num)))
+
+/*********************************************************************
+ * TYPEDEFS
+ */
+
+// Fixed-point conversion of one range
+typedef struct
+{
+  uint32_t gain;    // Multiplier, MULTIMETER_SCALE_GAIN_SHIFT fractional bits
+  int32_t  offset;  // Added after scaling, in output units
+} multimeterScale_t;
+
+/*********************************************************************
+ * FUNCTIONS
+ */
+
+/*
+ * MultimeterScale_apply - Converts an ADC input voltage to the reading of
+ *                         the given range using integer arithmetic only.
+ *
+ *    mode - multimeter range
+ *    microVolt - voltage at the ADC input in uV
+ */
+extern int32_t MultimeterScale_apply(MultimeterMode mode, uint32_t microVolt);
+
+/*********************************************************************
+*********************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MULTIMETER_SCALE_H */
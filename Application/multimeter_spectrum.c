@@ -0,0 +1,306 @@
+/******************************************************************************
+
+ @file  multimeter_spectrum.c
+
+ @brief This file contains the Multimeter spectrum analysis. The
+        amplitudes of a few selected frequencies, such as the harmonics of
+        a switching supply ripple, are measured on every acquisition
+        window with a bank of Goertzel detectors.
+
+ Group: WCS, BTS
+ Target Device: CC1350
+
+ ******************************************************************************
+
+ Copyright (c) 2013-2017, Texas Instruments Incorporated
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+
+ *  Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+ *  Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+ *  Neither the name of Texas Instruments Incorporated nor the names of
+    its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ Release Name: ti-ble-2.3.2-stack-sdk_1_50_xx
+ Release Date: 2017-09-27 14:52:16
+ *****************************************************************************/
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include <stddef.h>
+
+#include "multimeter_spectrum.h"
+#include "multimeter_reduce.h"
+
+/*********************************************************************
+ * CONSTANTS
+ */
+
+// Fixed point format of the cosine evaluation
+#define SPECTRUM_ONE                          (1L << 30)
+
+// pi/2 and pi with 30 fractional bits
+#define SPECTRUM_HALF_PI                      1686629713L
+#define SPECTRUM_PI                           3373259426LL
+
+// Fractional bits of the phase increment in turns per sample
+#define SPECTRUM_PHASE_FRAC_BITS              24
+
+/*********************************************************************
+ * LOCAL VARIABLES
+ */
+
+// Selected bins
+static uint32_t spectrumFrequencies[MULTIMETER_SPECTRUM_MAX_BINS];
+static uint8_t spectrumBins = 0;
+
+// Goertzel coefficients of the bins and the sampling frequency they were
+// computed for
+static int32_t spectrumCoeffs[MULTIMETER_SPECTRUM_MAX_BINS];
+static uint32_t spectrumCoeffFrequency = 0;
+
+// Amplitudes of the latest committed window
+static uint32_t spectrumAmplitudes[MULTIMETER_SPECTRUM_MAX_BINS];
+static uint8_t spectrumMeasured = 0;
+
+// Amplitudes of the window processed last, published by
+// MultimeterSpectrum_commit once its samples proved intact
+static uint32_t spectrumWindowAmplitudes[MULTIMETER_SPECTRUM_MAX_BINS];
+static uint8_t spectrumWindowMeasured = 0;
+
+/*********************************************************************
+ * PUBLIC FUNCTIONS
+ */
+
+/*********************************************************************
+ * @fn      MultimeterSpectrum_setBins
+ *
+ * @brief   Selects the frequencies to analyse.
+ *
+ * @param   frequencies - bin frequencies in Hz.
+ * @param   count - number of bins, 0 turns the analysis off.
+ *
+ * @return  true on success, false otherwise.
+ */
+bool MultimeterSpectrum_setBins(const uint32_t *frequencies, uint8_t count)
+{
+  uint8_t i;
+
+  if (count > MULTIMETER_SPECTRUM_MAX_BINS)
+  {
+    return (false);
+  }
+
+  for (i = 0; i < count; i++)
+  {
+    spectrumFrequencies[i] = frequencies[i];
+  }
+  spectrumBins = count;
+
+  // Coefficients and amplitudes belong to the previous bins
+  spectrumCoeffFrequency = 0;
+  spectrumMeasured = 0;
+  spectrumWindowMeasured = 0;
+
+  return (true);
+}
+
+/*********************************************************************
+ * @fn      MultimeterSpectrum_getBins
+ *
+ * @brief   Returns the selected frequencies.
+ *
+ * @param   frequencies - frequencies output, NULL for the count only.
+ *
+ * @return  Number of bins.
+ */
+uint8_t MultimeterSpectrum_getBins(uint32_t *frequencies)
+{
+  uint8_t i;
+
+  for (i = 0; frequencies != NULL && i < spectrumBins; i++)
+  {
+    frequencies[i] = spectrumFrequencies[i];
+  }
+
+  return (spectrumBins);
+}
+
+/*********************************************************************
+ * @fn      MultimeterSpectrum_process
+ *
+ * @brief   Runs a Goertzel detector per bin over the window. A bank of
+ *          a few bins costs about two multiply-accumulates per sample
+ *          and bin and needs no buffer besides the window, unlike a
+ *          full FFT. The amplitudes are held until
+ *          MultimeterSpectrum_commit publishes them.
+ *
+ * @param   samples - raw ADC codes.
+ * @param   count - number of samples.
+ * @param   samplingFrequency - ADC sampling frequency in Hz.
+ *
+ * @return  None.
+ */
+void MultimeterSpectrum_process(const uint16_t *samples, uint16_t count,
+                                uint32_t samplingFrequency)
+{
+  uint64_t power;
+  uint8_t i;
+
+  if (spectrumBins == 0 || count == 0)
+  {
+    return;
+  }
+
+  // The sampling frequency changes with the acquisition configuration
+  if (spectrumCoeffFrequency != samplingFrequency)
+  {
+    for (i = 0; i < spectrumBins; i++)
+    {
+      spectrumCoeffs[i] = MultimeterSpectrum_coeff(spectrumFrequencies[i], samplingFrequency);
+    }
+    spectrumCoeffFrequency = samplingFrequency;
+  }
+
+  for (i = 0; i < spectrumBins; i++)
+  {
+    if (spectrumFrequencies[i] >= samplingFrequency / 2)
+    {
+      spectrumWindowAmplitudes[i] = 0;
+      continue;
+    }
+
+    // power = amplitude^2 * count^2 / 4
+    power = MultimeterReduce_tonePower(samples, count, spectrumCoeffs[i]);
+    spectrumWindowAmplitudes[i] = ((MultimeterReduce_sqrt(power) <<
+                                    (MULTIMETER_SPECTRUM_AMPLITUDE_FRAC_BITS + 1)) + count / 2) / count;
+  }
+  spectrumWindowMeasured = spectrumBins;
+}
+
+/*********************************************************************
+ * @fn      MultimeterSpectrum_commit
+ *
+ * @brief   Publishes the amplitudes of the window processed last.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+void MultimeterSpectrum_commit(void)
+{
+  uint8_t i;
+
+  if (spectrumWindowMeasured == 0)
+  {
+    return;
+  }
+
+  for (i = 0; i < spectrumWindowMeasured; i++)
+  {
+    spectrumAmplitudes[i] = spectrumWindowAmplitudes[i];
+  }
+  spectrumMeasured = spectrumWindowMeasured;
+  spectrumWindowMeasured = 0;
+}
+
+/*********************************************************************
+ * @fn      MultimeterSpectrum_getAmplitudes
+ *
+ * @brief   Returns the amplitudes of the latest window.
+ *
+ * @param   amplitudes - amplitudes output.
+ *
+ * @return  Number of bins, 0 if none was measured yet.
+ */
+uint8_t MultimeterSpectrum_getAmplitudes(uint32_t *amplitudes)
+{
+  uint8_t i;
+
+  for (i = 0; i < spectrumMeasured; i++)
+  {
+    amplitudes[i] = spectrumAmplitudes[i];
+  }
+
+  return (spectrumMeasured);
+}
+
+/*********************************************************************
+ * @fn      MultimeterSpectrum_coeff
+ *
+ * @brief   Goertzel coefficient of a tone. The cosine is evaluated in
+ *          fixed point with its Taylor series up to x^10 on [0, pi/2],
+ *          accurate to far below the 14 fractional bits of the result.
+ *
+ * @param   frequency - tone frequency in Hz, below samplingFrequency / 2.
+ * @param   samplingFrequency - sampling frequency in Hz.
+ *
+ * @return  2*cos(2*pi*f/fs), MULTIMETER_REDUCE_TONE_SHIFT fractional bits.
+ */
+int32_t MultimeterSpectrum_coeff(uint32_t frequency, uint32_t samplingFrequency)
+{
+  uint32_t phase;
+  int64_t angle;
+  int64_t x2;
+  int64_t c;
+  bool negate = false;
+
+  if (samplingFrequency == 0)
+  {
+    return (0);
+  }
+
+  // Phase increment per sample in turns, then radians with 30 bits
+  phase = (uint32_t)(((uint64_t)frequency << SPECTRUM_PHASE_FRAC_BITS) / samplingFrequency);
+  angle = ((int64_t)phase * (2 * SPECTRUM_PI)) >> SPECTRUM_PHASE_FRAC_BITS;
+
+  // cos(x) = -cos(pi - x)
+  if (angle > SPECTRUM_HALF_PI)
+  {
+    angle = SPECTRUM_PI - angle;
+    negate = true;
+  }
+
+  // 1 - x^2/2! + x^4/4! - ... in Horner form
+  x2 = (angle * angle) >> 30;
+  c = SPECTRUM_ONE - x2 / 90;
+  c = SPECTRUM_ONE - ((x2 * c) >> 30) / 56;
+  c = SPECTRUM_ONE - ((x2 * c) >> 30) / 30;
+  c = SPECTRUM_ONE - ((x2 * c) >> 30) / 12;
+  c = SPECTRUM_ONE - ((x2 * c) >> 30) / 2;
+
+  if (negate)
+  {
+    c = -c;
+  }
+
+  // 2*c with 30 fractional bits to MULTIMETER_REDUCE_TONE_SHIFT bits, rounded
+  return ((int32_t)((c + (1L << (29 - MULTIMETER_REDUCE_TONE_SHIFT))) >>
+                    (29 - MULTIMETER_REDUCE_TONE_SHIFT)));
+}
+
+/*********************************************************************
+*********************************************************************/
@@ -0,0 +1,145 @@
+/******************************************************************************
+
+ @file  multimeter_spectrum.h
+
+ @brief This file contains the Multimeter spectrum analysis definitions
+        and prototypes.
+
+ Group: WCS, BTS
+ Target Device: CC1350
+
+ ******************************************************************************
+
+ Copyright (c) 2013-2017, Texas Instruments Incorporated
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+
+ *  Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+ *  Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+ *  Neither the name of Texas Instruments Incorporated nor the names of
+    its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ Release Name: ti-ble-2.3.2-stack-sdk_1_50_xx
+ Release Date: 2017-09-27 14:52:16
+ *****************************************************************************/
+
+#ifndef MULTIMETER_SPECTRUM_H
+#define MULTIMETER_SPECTRUM_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************************************************************
+ * CONSTANTS
+ */
+
+// Largest number of spectrum bins
+#define MULTIMETER_SPECTRUM_MAX_BINS          8
+
+// Fractional bits of the bin amplitudes, in raw ADC codes
+#define MULTIMETER_SPECTRUM_AMPLITUDE_FRAC_BITS 4
+
+/*********************************************************************
+ * FUNCTIONS
+ */
+
+/*
+ * MultimeterSpectrum_setBins - Selects the frequencies to analyse, an
+ *                              empty list turns the analysis off.
+ *
+ *    frequencies - bin frequencies in Hz
+ *    count - number of bins, at most MULTIMETER_SPECTRUM_MAX_BINS
+ *
+ * @return  true on success, false if count is out of range
+ */
+extern bool MultimeterSpectrum_setBins(const uint32_t *frequencies, uint8_t count);
+
+/*
+ * MultimeterSpectrum_getBins - Returns the selected frequencies.
+ *
+ *    frequencies - output for up to MULTIMETER_SPECTRUM_MAX_BINS
+ *                  frequencies in Hz, NULL for the count only
+ *
+ * @return  number of bins
+ */
+extern uint8_t MultimeterSpectrum_getBins(uint32_t *frequencies);
+
+/*
+ * MultimeterSpectrum_process - Measures the amplitude of every bin in a
+ *                              window, held until they are committed.
+ *                              Bins at or above half the sampling
+ *                              frequency read 0.
+ *
+ *    samples - raw ADC codes
+ *    count - number of samples, at most 1024
+ *    samplingFrequency - ADC sampling frequency in Hz
+ */
+extern void MultimeterSpectrum_process(const uint16_t *samples, uint16_t count,
+                                       uint32_t samplingFrequency);
+
+/*
+ * MultimeterSpectrum_commit - Publishes the amplitudes of the window
+ *                             processed last, once the window proved
+ *                             intact.
+ */
+extern void MultimeterSpectrum_commit(void);
+
+/*
+ * MultimeterSpectrum_getAmplitudes - Returns the amplitudes of the latest
+ *                                    window.
+ *
+ *    amplitudes - output for up to MULTIMETER_SPECTRUM_MAX_BINS peak
+ *                 amplitudes in raw codes with
+ *                 MULTIMETER_SPECTRUM_AMPLITUDE_FRAC_BITS fractional bits
+ *
+ * @return  number of bins, 0 if none was measured yet
+ */
+extern uint8_t MultimeterSpectrum_getAmplitudes(uint32_t *amplitudes);
+
+/*
+ * MultimeterSpectrum_coeff - Goertzel coefficient 2*cos(2*pi*f/fs) with
+ *                            MULTIMETER_REDUCE_TONE_SHIFT fractional bits.
+ *
+ *    frequency - tone frequency in Hz, below samplingFrequency / 2
+ *    samplingFrequency - sampling frequency in Hz
+ */
+extern int32_t MultimeterSpectrum_coeff(uint32_t frequency, uint32_t samplingFrequency);
+
+/*********************************************************************
+*********************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MULTIMETER_SPECTRUM_H */
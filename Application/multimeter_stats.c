@@ -0,0 +1,260 @@
+/******************************************************************************
+
+ @file  multimeter_stats.c
+
+ @brief This file contains the Multimeter statistics engine. It keeps the
+        count, mean, standard deviation and the lowest and highest single
+        sample of the full rate raw sample stream since the last reset, in
+        constant time and memory per sample.
+
+ Group: WCS, BTS
+ Target Device: CC1350
+
+ ******************************************************************************
+
+ Copyright (c) 2013-2017, Texas Instruments Incorporated
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+
+ *  Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+ *  Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+ *  Neither the name of Texas Instruments Incorporated nor the names of
+    its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ Release Name: ti-ble-2.3.2-stack-sdk_1_50_xx
+ Release Date: 2017-09-27 14:52:16
+ *****************************************************************************/
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include "multimeter_stats.h"
+#include "multimeter_reduce.h"
+
+/*********************************************************************
+ * CONSTANTS
+ */
+
+// Fractional bits of the sum of squared deviations
+#define STATS_M2_FRAC_BITS                    8
+
+/*********************************************************************
+ * LOCAL VARIABLES
+ */
+
+// Number of samples since the last reset
+static uint32_t statsCount = 0;
+
+// Running mean, MULTIMETER_STATS_MEAN_FRAC_BITS fractional bits
+static uint32_t statsMean = 0;
+
+// Sum of squared deviations from the mean, STATS_M2_FRAC_BITS fractional
+// bits. Stays below 2^62 for 12-bit codes and 2^32 samples.
+static uint64_t statsM2 = 0;
+
+static uint16_t statsMin = 0;
+static uint16_t statsMax = 0;
+
+// Statistics of the window processed last, merged by
+// MultimeterStats_commitWindow once its samples proved intact
+static uint16_t statsWindowCount = 0;
+static uint32_t statsWindowMean = 0;
+static uint64_t statsWindowM2 = 0;
+static uint16_t statsWindowMin = 0;
+static uint16_t statsWindowMax = 0;
+
+/*********************************************************************
+ * PUBLIC FUNCTIONS
+ */
+
+/*********************************************************************
+ * @fn      MultimeterStats_reset
+ *
+ * @brief   Clears the statistics.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+void MultimeterStats_reset(void)
+{
+  statsCount = 0;
+  statsMean = 0;
+  statsM2 = 0;
+  statsMin = 0;
+  statsMax = 0;
+  statsWindowCount = 0;
+}
+
+/*********************************************************************
+ * @fn      MultimeterStats_processWindow
+ *
+ * @brief   Computes the statistics of a window of samples on their own.
+ *          The samples only go through a sum, a sum of squares and the
+ *          min/max compares. The result is held until
+ *          MultimeterStats_commitWindow merges it.
+ *
+ * @param   samples - raw 12-bit ADC codes.
+ * @param   count - number of samples.
+ *
+ * @return  None.
+ */
+void MultimeterStats_processWindow(const uint16_t *samples, uint16_t count)
+{
+  const uint16_t *pEnd;
+  uint32_t sum = 0;
+  uint64_t sumSquares = 0;
+  uint64_t sumSquared;
+  uint16_t min = 0xFFFF;
+  uint16_t max = 0;
+  uint32_t code;
+
+  // Freeze once the sample count would wrap
+  if (count > UINT32_MAX - statsCount)
+  {
+    count = (uint16_t)(UINT32_MAX - statsCount);
+  }
+  statsWindowCount = count;
+  if (count == 0)
+  {
+    return;
+  }
+
+  pEnd = samples + count;
+  while (samples < pEnd)
+  {
+    code = *samples++;
+    sum += code;
+    sumSquares += code * code;
+    if (code < min)
+    {
+      min = (uint16_t)code;
+    }
+    if (code > max)
+    {
+      max = (uint16_t)code;
+    }
+  }
+
+  // Mean and squared deviations of the window on their own, the sum^2 / count
+  // term is split so that it does not overflow when shifted
+  statsWindowMean = (uint32_t)((((uint64_t)sum << MULTIMETER_STATS_MEAN_FRAC_BITS) + count / 2) / count);
+  sumSquared = (uint64_t)sum * sum;
+  statsWindowM2 = (sumSquares << STATS_M2_FRAC_BITS) -
+                  (((sumSquared / count) << STATS_M2_FRAC_BITS) +
+                   (((sumSquared % count) << STATS_M2_FRAC_BITS) / count));
+  statsWindowMin = min;
+  statsWindowMax = max;
+}
+
+/*********************************************************************
+ * @fn      MultimeterStats_commitWindow
+ *
+ * @brief   Merges the window processed last into the running statistics
+ *          with the pairwise form of Welford's update:
+ *
+ *            mean += delta * nb / n
+ *            M2   += M2b + delta^2 * na * nb / n
+ *
+ *          This keeps Welford's numerical behaviour without a division
+ *          per sample. A window is merged at most once.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+void MultimeterStats_commitWindow(void)
+{
+  uint16_t count = statsWindowCount;
+  uint32_t n;
+  int64_t delta;
+  uint64_t weight;
+
+  if (count == 0)
+  {
+    return;
+  }
+  statsWindowCount = 0;
+
+  if (statsCount == 0)
+  {
+    statsCount = count;
+    statsMean = statsWindowMean;
+    statsM2 = statsWindowM2;
+    statsMin = statsWindowMin;
+    statsMax = statsWindowMax;
+    return;
+  }
+
+  n = statsCount + count;
+  delta = (int64_t)statsWindowMean - (int64_t)statsMean;
+
+  // na * nb / n with 8 fractional bits, delta^2 is brought down to the
+  // fractional bits of M2 before the multiplication
+  weight = (((uint64_t)statsCount * count) << 8) / n;
+  statsM2 += statsWindowM2 + (((((uint64_t)(delta * delta)) >>
+                               (2 * MULTIMETER_STATS_MEAN_FRAC_BITS - STATS_M2_FRAC_BITS)) * weight) >> 8);
+  statsMean = (uint32_t)((int64_t)statsMean + (delta * count) / n);
+  statsCount = n;
+
+  if (statsWindowMin < statsMin)
+  {
+    statsMin = statsWindowMin;
+  }
+  if (statsWindowMax > statsMax)
+  {
+    statsMax = statsWindowMax;
+  }
+}
+
+/*********************************************************************
+ * @fn      MultimeterStats_get
+ *
+ * @brief   Returns the statistics since the last reset.
+ *
+ * @param   pSummary - statistics output.
+ *
+ * @return  false if no sample was added since the last reset.
+ */
+bool MultimeterStats_get(multimeterStatsSummary_t *pSummary)
+{
+  if (statsCount == 0)
+  {
+    return (false);
+  }
+
+  pSummary->count = statsCount;
+  pSummary->mean = statsMean;
+  // sqrt halves the fractional bits of the variance
+  pSummary->stdDev = MultimeterReduce_sqrt(statsM2 / statsCount) <<
+                     (MULTIMETER_STATS_STD_DEV_FRAC_BITS - STATS_M2_FRAC_BITS / 2);
+  pSummary->min = statsMin;
+  pSummary->max = statsMax;
+
+  return (true);
+}
+
+/*********************************************************************
+*********************************************************************/
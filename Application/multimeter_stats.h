@@ -0,0 +1,128 @@
+/******************************************************************************
+
+ @file  multimeter_stats.h
+
+ @brief This file contains the Multimeter statistics engine definitions
+        and prototypes.
+
+ Group: WCS, BTS
+ Target Device: CC1350
+
+ ******************************************************************************
+
+ Copyright (c) 2013-2017, Texas Instruments Incorporated
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+
+ *  Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+ *  Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+ *  Neither the name of Texas Instruments Incorporated nor the names of
+    its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ Release Name: ti-ble-2.3.2-stack-sdk_1_50_xx
+ Release Date: 2017-09-27 14:52:16
+ *****************************************************************************/
+
+#ifndef MULTIMETER_STATS_H
+#define MULTIMETER_STATS_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************************************************************
+ * CONSTANTS
+ */
+
+// Fractional bits of the mean and of the standard deviation, in raw codes
+#define MULTIMETER_STATS_MEAN_FRAC_BITS       16
+#define MULTIMETER_STATS_STD_DEV_FRAC_BITS    4
+
+/*********************************************************************
+ * TYPEDEFS
+ */
+
+// Statistics since the last reset, in raw ADC codes
+typedef struct
+{
+  uint32_t count;         // Number of samples
+  uint32_t mean;          // Mean, MULTIMETER_STATS_MEAN_FRAC_BITS fractional bits
+  uint32_t stdDev;        // Standard deviation, MULTIMETER_STATS_STD_DEV_FRAC_BITS fractional bits
+  uint16_t min;           // Lowest single sample
+  uint16_t max;           // Highest single sample
+} multimeterStatsSummary_t;
+
+/*********************************************************************
+ * FUNCTIONS
+ */
+
+/*
+ * MultimeterStats_reset - Clears the statistics.
+ */
+extern void MultimeterStats_reset(void);
+
+/*
+ * MultimeterStats_processWindow - Computes the statistics of a window of
+ *                                 raw ADC codes in constant time per
+ *                                 sample, held until they are committed.
+ *                                 Samples beyond a count of 2^32 - 1 are
+ *                                 ignored until the next reset.
+ *
+ *    samples - raw 12-bit ADC codes
+ *    count - number of samples
+ */
+extern void MultimeterStats_processWindow(const uint16_t *samples, uint16_t count);
+
+/*
+ * MultimeterStats_commitWindow - Merges the window processed last into
+ *                                the running statistics, once the window
+ *                                proved intact.
+ */
+extern void MultimeterStats_commitWindow(void);
+
+/*
+ * MultimeterStats_get - Returns the statistics since the last reset.
+ *
+ *    pSummary - statistics output
+ *
+ * @return  false if no sample was added since the last reset
+ */
+extern bool MultimeterStats_get(multimeterStatsSummary_t *pSummary);
+
+/*********************************************************************
+*********************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MULTIMETER_STATS_H */
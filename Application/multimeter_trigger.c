@@ -0,0 +1,365 @@
+/******************************************************************************
+
+ @file  multimeter_trigger.c
+
+ @brief This file contains the Multimeter trigger engine. While armed, the
+        raw sample stream is recorded into a circular buffer sized for the
+        pre-trigger and post-trigger samples, so once the trigger fires
+        the history ahead of it is already in place. When the post-trigger
+        samples are in, the capture is frozen in wire order until the
+        trigger is armed again.
+
+ Group: WCS, BTS
+ Target Device: CC1350
+
+ ******************************************************************************
+
+ Copyright (c) 2013-2017, Texas Instruments Incorporated
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+
+ *  Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+ *  Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+ *  Neither the name of Texas Instruments Incorporated nor the names of
+    its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ Release Name: ti-ble-2.3.2-stack-sdk_1_50_xx
+ Release Date: 2017-09-27 14:52:16
+ *****************************************************************************/
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include <stddef.h>
+
+#include "multimeter_trigger.h"
+
+/*********************************************************************
+ * LOCAL VARIABLES
+ */
+
+// Circular capture buffer, holds the capture in order once frozen
+static uint16_t triggerBuffer[MULTIMETER_TRIGGER_MAX_SAMPLES];
+
+static multimeterTriggerConfig_t triggerConfig =
+{
+  MultimeterTriggerType_Off,
+  MultimeterTriggerSlope_Rising,
+  0,
+  0,
+  0,
+  1
+};
+
+static MultimeterTriggerState triggerState = MultimeterTriggerState_Idle;
+
+// Size of the circular buffer in use, preSamples + postSamples
+static uint16_t triggerCapacity;
+
+// Next write position and number of valid samples in the buffer
+static uint16_t triggerHead;
+static uint16_t triggerFill;
+
+// Post-trigger samples still to record
+static uint16_t triggerRemaining;
+
+// Samples in the frozen capture
+static uint16_t triggerCaptured;
+
+// Side of the level of the previous sample, for the edge trigger
+static bool triggerPrevAbove;
+static bool triggerPrevValid;
+
+/*********************************************************************
+ * LOCAL FUNCTIONS
+ */
+static bool MultimeterTrigger_fires(uint16_t code);
+static void MultimeterTrigger_reverse(uint16_t *p, uint16_t count);
+static void MultimeterTrigger_freeze(void);
+
+/*********************************************************************
+ * PUBLIC FUNCTIONS
+ */
+
+/*********************************************************************
+ * @fn      MultimeterTrigger_arm
+ *
+ * @brief   Drops any capture and arms the trigger with a new
+ *          configuration. The pre-trigger history starts empty.
+ *
+ * @param   pConfig - trigger configuration.
+ *
+ * @return  None.
+ */
+void MultimeterTrigger_arm(const multimeterTriggerConfig_t *pConfig)
+{
+  triggerConfig = *pConfig;
+
+  if (triggerConfig.type >= MultimeterTriggerType_Count)
+  {
+    triggerConfig.type = MultimeterTriggerType_Off;
+  }
+
+  // The trigger sample itself is the first post-trigger sample
+  if (triggerConfig.postSamples == 0)
+  {
+    triggerConfig.postSamples = 1;
+  }
+  else if (triggerConfig.postSamples > MULTIMETER_TRIGGER_MAX_SAMPLES)
+  {
+    triggerConfig.postSamples = MULTIMETER_TRIGGER_MAX_SAMPLES;
+  }
+
+  if (triggerConfig.preSamples > MULTIMETER_TRIGGER_MAX_SAMPLES - triggerConfig.postSamples)
+  {
+    triggerConfig.preSamples = MULTIMETER_TRIGGER_MAX_SAMPLES - triggerConfig.postSamples;
+  }
+
+  triggerCapacity = triggerConfig.preSamples + triggerConfig.postSamples;
+  triggerHead = 0;
+  triggerFill = 0;
+  triggerCaptured = 0;
+  triggerPrevValid = false;
+
+  triggerState = (triggerConfig.type == MultimeterTriggerType_Off) ?
+                 MultimeterTriggerState_Idle : MultimeterTriggerState_Armed;
+}
+
+/*********************************************************************
+ * @fn      MultimeterTrigger_getConfig
+ *
+ * @brief   Returns the trigger configuration in use.
+ *
+ * @param   pConfig - configuration output.
+ *
+ * @return  None.
+ */
+void MultimeterTrigger_getConfig(multimeterTriggerConfig_t *pConfig)
+{
+  *pConfig = triggerConfig;
+}
+
+/*********************************************************************
+ * @fn      MultimeterTrigger_getState
+ *
+ * @brief   Returns the trigger engine state.
+ *
+ * @param   None.
+ *
+ * @return  Trigger state.
+ */
+MultimeterTriggerState MultimeterTrigger_getState(void)
+{
+  return (triggerState);
+}
+
+/*********************************************************************
+ * @fn      MultimeterTrigger_process
+ *
+ * @brief   Runs the trigger over a block of raw codes. Costs one compare
+ *          and one store per sample while armed or triggered and nothing
+ *          otherwise.
+ *
+ * @param   samples - raw ADC codes, in acquisition order.
+ * @param   count - number of samples.
+ *
+ * @return  true if a capture was completed by this block.
+ */
+bool MultimeterTrigger_process(const uint16_t *samples, uint16_t count)
+{
+  uint16_t code;
+  uint16_t i;
+
+  for (i = 0; i < count; i++)
+  {
+    code = samples[i];
+
+    if (triggerState == MultimeterTriggerState_Armed)
+    {
+      if (MultimeterTrigger_fires(code))
+      {
+        // Keep the history gathered so far, at most preSamples of it
+        if (triggerFill > triggerConfig.preSamples)
+        {
+          triggerFill = triggerConfig.preSamples;
+        }
+        triggerRemaining = triggerConfig.postSamples;
+        triggerState = MultimeterTriggerState_Triggered;
+      }
+    }
+    else if (triggerState != MultimeterTriggerState_Triggered)
+    {
+      return (false);
+    }
+
+    triggerBuffer[triggerHead] = code;
+    if (++triggerHead == triggerCapacity)
+    {
+      triggerHead = 0;
+    }
+    if (triggerFill < triggerCapacity)
+    {
+      triggerFill++;
+    }
+
+    if ((triggerState == MultimeterTriggerState_Triggered) &&
+        (--triggerRemaining == 0))
+    {
+      MultimeterTrigger_freeze();
+      return (true);
+    }
+  }
+
+  return (false);
+}
+
+/*********************************************************************
+ * @fn      MultimeterTrigger_getCapture
+ *
+ * @brief   Returns the frozen capture.
+ *
+ * @param   pLen - capture length in bytes.
+ *
+ * @return  Capture as big endian 16-bit codes, NULL if none.
+ */
+const uint8_t *MultimeterTrigger_getCapture(uint16_t *pLen)
+{
+  if (triggerState != MultimeterTriggerState_Captured)
+  {
+    *pLen = 0;
+    return (NULL);
+  }
+
+  *pLen = triggerCaptured * sizeof(uint16_t);
+  return ((const uint8_t *)triggerBuffer);
+}
+
+/*********************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+/*********************************************************************
+ * @fn      MultimeterTrigger_fires
+ *
+ * @brief   Evaluates the trigger condition on one sample.
+ *
+ * @param   code - raw ADC code.
+ *
+ * @return  true if the trigger fires on this sample.
+ */
+static bool MultimeterTrigger_fires(uint16_t code)
+{
+  bool above = (code >= triggerConfig.level);
+  bool fires;
+
+  switch (triggerConfig.type)
+  {
+    case MultimeterTriggerType_Level:
+      fires = (triggerConfig.slope == MultimeterTriggerSlope_Rising) ? above : !above;
+      break;
+
+    case MultimeterTriggerType_Edge:
+      fires = triggerPrevValid && (above != triggerPrevAbove) &&
+              (above == (triggerConfig.slope == MultimeterTriggerSlope_Rising));
+      break;
+
+    case MultimeterTriggerType_Window:
+      fires = (code < triggerConfig.level) || (code > triggerConfig.highLevel);
+      break;
+
+    default:
+      fires = false;
+      break;
+  }
+
+  triggerPrevAbove = above;
+  triggerPrevValid = true;
+
+  return (fires);
+}
+
+/*********************************************************************
+ * @fn      MultimeterTrigger_reverse
+ *
+ * @brief   Reverses a run of samples in place.
+ *
+ * @param   p - first sample.
+ * @param   count - number of samples.
+ *
+ * @return  None.
+ */
+static void MultimeterTrigger_reverse(uint16_t *p, uint16_t count)
+{
+  uint16_t *q = p + count - 1;
+  uint16_t tmp;
+
+  while (p < q)
+  {
+    tmp = *p;
+    *p++ = *q;
+    *q-- = tmp;
+  }
+}
+
+/*********************************************************************
+ * @fn      MultimeterTrigger_freeze
+ *
+ * @brief   Rotates the circular buffer so the capture starts at index 0
+ *          and converts it to big endian for download.
+ *
+ * @param   None.
+ *
+ * @return  None.
+ */
+static void MultimeterTrigger_freeze(void)
+{
+  uint16_t start;
+  uint16_t code;
+  uint16_t i;
+
+  // Oldest sample of the capture
+  start = (triggerHead + triggerCapacity - triggerFill) % triggerCapacity;
+
+  // Rotate left by start with three reversals, no extra buffer needed
+  if (start > 0)
+  {
+    MultimeterTrigger_reverse(triggerBuffer, start);
+    MultimeterTrigger_reverse(&triggerBuffer[start], triggerCapacity - start);
+    MultimeterTrigger_reverse(triggerBuffer, triggerCapacity);
+  }
+
+  for (i = 0; i < triggerFill; i++)
+  {
+    code = triggerBuffer[i];
+    ((uint8_t *)&triggerBuffer[i])[0] = (uint8_t)(code >> 8);
+    ((uint8_t *)&triggerBuffer[i])[1] = (uint8_t)(code & 0xFF);
+  }
+
+  triggerCaptured = triggerFill;
+  triggerState = MultimeterTriggerState_Captured;
+}
+
+/*********************************************************************
+*********************************************************************/
@@ -0,0 +1,171 @@
+/******************************************************************************
+
+ @file  multimeter_trigger.h
+
+ @brief This file contains the Multimeter trigger and capture definitions
+        and prototypes.
+
+ Group: WCS, BTS
+ Target Device: CC1350
+
+ ******************************************************************************
+
+ Copyright (c) 2013-2017, Texas Instruments Incorporated
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+
+ *  Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+ *  Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+ *  Neither the name of Texas Instruments Incorporated nor the names of
+    its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ Release Name: ti-ble-2.3.2-stack-sdk_1_50_xx
+ Release Date: 2017-09-27 14:52:16
+ *****************************************************************************/
+
+#ifndef MULTIMETER_TRIGGER_H
+#define MULTIMETER_TRIGGER_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************************************************************
+ * CONSTANTS
+ */
+
+// Largest capture, pre-trigger and post-trigger samples together
+#ifndef MULTIMETER_TRIGGER_MAX_SAMPLES
+#define MULTIMETER_TRIGGER_MAX_SAMPLES        512
+#endif
+
+/*********************************************************************
+ * TYPEDEFS
+ */
+
+/*!
+ *  @def    MultimeterTriggerType
+ *  @brief  Enum of trigger conditions, evaluated on raw ADC codes
+ */
+typedef enum MultimeterTriggerType {
+    MultimeterTriggerType_Off = 0,  // Trigger disabled
+    MultimeterTriggerType_Level,    // Sample is above (rising) or below (falling) the level
+    MultimeterTriggerType_Edge,     // Sample crosses the level in the slope direction
+    MultimeterTriggerType_Window,   // Sample is outside [level, highLevel]
+
+    MultimeterTriggerType_Count
+} MultimeterTriggerType;
+
+/*!
+ *  @def    MultimeterTriggerSlope
+ *  @brief  Enum of trigger directions of the level and edge triggers
+ */
+typedef enum MultimeterTriggerSlope {
+    MultimeterTriggerSlope_Rising = 0,
+    MultimeterTriggerSlope_Falling
+} MultimeterTriggerSlope;
+
+/*!
+ *  @def    MultimeterTriggerState
+ *  @brief  Enum of trigger engine states
+ */
+typedef enum MultimeterTriggerState {
+    MultimeterTriggerState_Idle = 0,    // Not armed
+    MultimeterTriggerState_Armed,       // Recording pre-trigger history
+    MultimeterTriggerState_Triggered,   // Recording post-trigger samples
+    MultimeterTriggerState_Captured     // Capture frozen until re-armed
+} MultimeterTriggerState;
+
+// Trigger configuration
+typedef struct
+{
+  uint8_t  type;          // MultimeterTriggerType
+  uint8_t  slope;         // MultimeterTriggerSlope
+  uint16_t level;         // Trigger level, raw ADC code
+  uint16_t highLevel;     // Upper level of the window trigger, raw ADC code
+  uint16_t preSamples;    // Samples kept ahead of the trigger
+  uint16_t postSamples;   // Samples recorded from the trigger on, at least 1
+} multimeterTriggerConfig_t;
+
+/*********************************************************************
+ * FUNCTIONS
+ */
+
+/*
+ * MultimeterTrigger_arm - Drops any capture and arms the trigger. Sample
+ *                         counts are clamped to fit the capture buffer.
+ *
+ *    pConfig - trigger configuration
+ */
+extern void MultimeterTrigger_arm(const multimeterTriggerConfig_t *pConfig);
+
+/*
+ * MultimeterTrigger_getConfig - Returns the configuration in use, after
+ *                               clamping.
+ *
+ *    pConfig - configuration output
+ */
+extern void MultimeterTrigger_getConfig(multimeterTriggerConfig_t *pConfig);
+
+/*
+ * MultimeterTrigger_getState - Returns the trigger engine state.
+ */
+extern MultimeterTriggerState MultimeterTrigger_getState(void);
+
+/*
+ * MultimeterTrigger_process - Feeds raw ADC codes in acquisition order.
+ *
+ *    samples - raw ADC codes
+ *    count - number of samples
+ *
+ * @return  true if a capture was completed by these samples
+ */
+extern bool MultimeterTrigger_process(const uint16_t *samples, uint16_t count);
+
+/*
+ * MultimeterTrigger_getCapture - Returns the frozen capture, oldest sample
+ *                                first, as big endian 16-bit codes.
+ *
+ *    pLen - capture length in bytes
+ *
+ * @return  capture, NULL if none
+ */
+extern const uint8_t *MultimeterTrigger_getCapture(uint16_t *pLen);
+
+/*********************************************************************
+*********************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MULTIMETER_TRIGGER_H */
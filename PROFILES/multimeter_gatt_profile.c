@@ -69,7 +69,7 @@
  * CONSTANTS
  */
 
-#define SERVAPP_NUM_ATTR_SUPPORTED        8
+#define SERVAPP_NUM_ATTR_SUPPORTED        41
 
 /*********************************************************************
  * TYPEDEFS
@@ -90,12 +90,78 @@ CONST uint8 multimeterProfilechar1UUID[ATT_BT_UUID_SIZE] =
   LO_UINT16(MULTIMETERPROFILE_CHAR1_UUID), HI_UINT16(MULTIMETERPROFILE_CHAR1_UUID)
 };
 
+// Characteristic 2 UUID: 0xFFF2
+CONST uint8 multimeterProfilechar2UUID[ATT_BT_UUID_SIZE] =
+{
+  LO_UINT16(MULTIMETERPROFILE_CHAR2_UUID), HI_UINT16(MULTIMETERPROFILE_CHAR2_UUID)
+};
+
+// Characteristic 3 UUID: 0xFFF3
+CONST uint8 multimeterProfilechar3UUID[ATT_BT_UUID_SIZE] =
+{
+  LO_UINT16(MULTIMETERPROFILE_CHAR3_UUID), HI_UINT16(MULTIMETERPROFILE_CHAR3_UUID)
+};
+
 // Characteristic 4 UUID: 0xFFF4
 CONST uint8 multimeterProfilechar4UUID[ATT_BT_UUID_SIZE] =
 {
   LO_UINT16(MULTIMETERPROFILE_CHAR4_UUID), HI_UINT16(MULTIMETERPROFILE_CHAR4_UUID)
 };
 
+// Characteristic 5 UUID: 0xFFF5
+CONST uint8 multimeterProfilechar5UUID[ATT_BT_UUID_SIZE] =
+{
+  LO_UINT16(MULTIMETERPROFILE_CHAR5_UUID), HI_UINT16(MULTIMETERPROFILE_CHAR5_UUID)
+};
+
+// Characteristic 6 UUID: 0xFFF6
+CONST uint8 multimeterProfilechar6UUID[ATT_BT_UUID_SIZE] =
+{
+  LO_UINT16(MULTIMETERPROFILE_CHAR6_UUID), HI_UINT16(MULTIMETERPROFILE_CHAR6_UUID)
+};
+
+// Characteristic 7 UUID: 0xFFF7
+CONST uint8 multimeterProfilechar7UUID[ATT_BT_UUID_SIZE] =
+{
+  LO_UINT16(MULTIMETERPROFILE_CHAR7_UUID), HI_UINT16(MULTIMETERPROFILE_CHAR7_UUID)
+};
+
+// Characteristic 8 UUID: 0xFFF8
+CONST uint8 multimeterProfilechar8UUID[ATT_BT_UUID_SIZE] =
+{
+  LO_UINT16(MULTIMETERPROFILE_CHAR8_UUID), HI_UINT16(MULTIMETERPROFILE_CHAR8_UUID)
+};
+
+// Characteristic 9 UUID: 0xFFF9
+CONST uint8 multimeterProfilechar9UUID[ATT_BT_UUID_SIZE] =
+{
+  LO_UINT16(MULTIMETERPROFILE_CHAR9_UUID), HI_UINT16(MULTIMETERPROFILE_CHAR9_UUID)
+};
+
+// Characteristic 10 UUID: 0xFFFA
+CONST uint8 multimeterProfilechar10UUID[ATT_BT_UUID_SIZE] =
+{
+  LO_UINT16(MULTIMETERPROFILE_CHAR10_UUID), HI_UINT16(MULTIMETERPROFILE_CHAR10_UUID)
+};
+
+// Characteristic 11 UUID: 0xFFFB
+CONST uint8 multimeterProfilechar11UUID[ATT_BT_UUID_SIZE] =
+{
+  LO_UINT16(MULTIMETERPROFILE_CHAR11_UUID), HI_UINT16(MULTIMETERPROFILE_CHAR11_UUID)
+};
+
+// Characteristic 12 UUID: 0xFFFC
+CONST uint8 multimeterProfilechar12UUID[ATT_BT_UUID_SIZE] =
+{
+  LO_UINT16(MULTIMETERPROFILE_CHAR12_UUID), HI_UINT16(MULTIMETERPROFILE_CHAR12_UUID)
+};
+
+// Characteristic 13 UUID: 0xFFFD
+CONST uint8 multimeterProfilechar13UUID[ATT_BT_UUID_SIZE] =
+{
+  LO_UINT16(MULTIMETERPROFILE_CHAR13_UUID), HI_UINT16(MULTIMETERPROFILE_CHAR13_UUID)
+};
+
 /*********************************************************************
  * EXTERNAL VARIABLES
  */
@@ -128,6 +194,26 @@ static uint8 multimeterProfileChar1 = 0;
 static uint8 multimeterProfileChar1UserDesp[17] = "Mode";
 
 
+// Multimeter Profile Characteristic 2 Properties
+static uint8 multimeterProfileChar2Props = GATT_PROP_READ | GATT_PROP_WRITE;
+
+// Characteristic 2 Value
+static uint8 multimeterProfileChar2[MULTIMETERPROFILE_CHAR2_LEN] = { 0 };
+
+// Multimeter Profile Characteristic 2 User Description
+static uint8 multimeterProfileChar2UserDesp[17] = "Acquisition";
+
+
+// Multimeter Profile Characteristic 3 Properties
+static uint8 multimeterProfileChar3Props = GATT_PROP_READ;
+
+// Characteristic 3 Value
+static uint8 multimeterProfileChar3[MULTIMETERPROFILE_CHAR3_LEN] = { 0 };
+
+// Multimeter Profile Characteristic 3 User Description
+static uint8 multimeterProfileChar3UserDesp[17] = "Status";
+
+
 // Multimeter Profile Characteristic 4 Properties
 static uint8 multimeterProfileChar4Props = GATT_PROP_NOTIFY;
 
@@ -143,6 +229,98 @@ static gattCharCfg_t *multimeterProfileChar4Config;
 // Multimeter Profile Characteristic 4 User Description
 static uint8 multimeterProfileChar4UserDesp[17] = "Measurement";
 
+
+// Multimeter Profile Characteristic 5 Properties
+static uint8 multimeterProfileChar5Props = GATT_PROP_READ | GATT_PROP_WRITE;
+
+// Characteristic 5 Value
+static uint8 multimeterProfileChar5[MULTIMETERPROFILE_CHAR5_LEN] = { 0 };
+
+// Multimeter Profile Characteristic 5 User Description
+static uint8 multimeterProfileChar5UserDesp[17] = "Trigger";
+
+
+// Multimeter Profile Characteristic 6 Properties
+static uint8 multimeterProfileChar6Props = GATT_PROP_READ;
+
+// Characteristic 6 Value, owned by the application
+static const uint8 *multimeterProfileChar6 = NULL;
+static uint16 multimeterProfileChar6Len = 0;
+
+// Multimeter Profile Characteristic 6 User Description
+static uint8 multimeterProfileChar6UserDesp[17] = "Capture";
+
+
+// Multimeter Profile Characteristic 7 Properties
+static uint8 multimeterProfileChar7Props = GATT_PROP_READ | GATT_PROP_WRITE;
+
+// Characteristic 7 Value
+static uint8 multimeterProfileChar7[MULTIMETERPROFILE_CHAR7_LEN] = { 0 };
+
+// Multimeter Profile Characteristic 7 User Description
+static uint8 multimeterProfileChar7UserDesp[17] = "Statistics";
+
+
+// Multimeter Profile Characteristic 8 Properties
+static uint8 multimeterProfileChar8Props = GATT_PROP_READ | GATT_PROP_WRITE;
+
+// Characteristic 8 Value
+static uint8 multimeterProfileChar8[MULTIMETERPROFILE_CHAR8_LEN] = { 0 };
+
+// Multimeter Profile Characteristic 8 User Description
+static uint8 multimeterProfileChar8UserDesp[17] = "Spectrum bins";
+
+
+// Multimeter Profile Characteristic 9 Properties
+static uint8 multimeterProfileChar9Props = GATT_PROP_READ;
+
+// Characteristic 9 Value
+static uint8 multimeterProfileChar9[MULTIMETERPROFILE_CHAR9_LEN] = { 0 };
+
+// Multimeter Profile Characteristic 9 User Description
+static uint8 multimeterProfileChar9UserDesp[17] = "Spectrum";
+
+
+// Multimeter Profile Characteristic 10 Properties
+static uint8 multimeterProfileChar10Props = GATT_PROP_READ | GATT_PROP_WRITE;
+
+// Characteristic 10 Value
+static uint8 multimeterProfileChar10[MULTIMETERPROFILE_CHAR10_LEN] = { 0 };
+
+// Multimeter Profile Characteristic 10 User Description
+static uint8 multimeterProfileChar10UserDesp[17] = "Charge";
+
+
+// Multimeter Profile Characteristic 11 Properties
+static uint8 multimeterProfileChar11Props = GATT_PROP_READ | GATT_PROP_WRITE;
+
+// Characteristic 11 Value
+static uint8 multimeterProfileChar11[MULTIMETERPROFILE_CHAR11_LEN] = { 0 };
+
+// Multimeter Profile Characteristic 11 User Description
+static uint8 multimeterProfileChar11UserDesp[17] = "Histogram setup";
+
+
+// Multimeter Profile Characteristic 12 Properties
+static uint8 multimeterProfileChar12Props = GATT_PROP_READ;
+
+// Characteristic 12 Value, owned by the application
+static const uint8 *multimeterProfileChar12 = NULL;
+static uint16 multimeterProfileChar12Len = 0;
+
+// Multimeter Profile Characteristic 12 User Description
+static uint8 multimeterProfileChar12UserDesp[17] = "Histogram";
+
+
+// Multimeter Profile Characteristic 13 Properties
+static uint8 multimeterProfileChar13Props = GATT_PROP_READ | GATT_PROP_WRITE;
+
+// Characteristic 13 Value
+static uint8 multimeterProfileChar13[MULTIMETERPROFILE_CHAR13_LEN] = { 0 };
+
+// Multimeter Profile Characteristic 13 User Description
+static uint8 multimeterProfileChar13UserDesp[17] = "Calibration";
+
 /*********************************************************************
  * Profile Attributes - Table
  */
@@ -181,6 +359,54 @@ static gattAttribute_t multimeterProfileAttrTbl[SERVAPP_NUM_ATTR_SUPPORTED] =
         multimeterProfileChar1UserDesp
       },
 
+    // Characteristic 2 Declaration
+    {
+      { ATT_BT_UUID_SIZE, characterUUID },
+      GATT_PERMIT_READ,
+      0,
+      &multimeterProfileChar2Props
+    },
+
+      // Characteristic Value 2
+      {
+        { ATT_BT_UUID_SIZE, multimeterProfilechar2UUID },
+        GATT_PERMIT_READ | GATT_PERMIT_WRITE,
+        0,
+        multimeterProfileChar2
+      },
+
+      // Characteristic 2 User Description
+      {
+        { ATT_BT_UUID_SIZE, charUserDescUUID },
+        GATT_PERMIT_READ,
+        0,
+        multimeterProfileChar2UserDesp
+      },
+
+    // Characteristic 3 Declaration
+    {
+      { ATT_BT_UUID_SIZE, characterUUID },
+      GATT_PERMIT_READ,
+      0,
+      &multimeterProfileChar3Props
+    },
+
+      // Characteristic Value 3
+      {
+        { ATT_BT_UUID_SIZE, multimeterProfilechar3UUID },
+        GATT_PERMIT_READ,
+        0,
+        multimeterProfileChar3
+      },
+
+      // Characteristic 3 User Description
+      {
+        { ATT_BT_UUID_SIZE, charUserDescUUID },
+        GATT_PERMIT_READ,
+        0,
+        multimeterProfileChar3UserDesp
+      },
+
     // Characteristic 4 Declaration
     {
       { ATT_BT_UUID_SIZE, characterUUID },
@@ -212,6 +438,222 @@ static gattAttribute_t multimeterProfileAttrTbl[SERVAPP_NUM_ATTR_SUPPORTED] =
         0,
         multimeterProfileChar4UserDesp
       },
+
+    // Characteristic 5 Declaration
+    {
+      { ATT_BT_UUID_SIZE, characterUUID },
+      GATT_PERMIT_READ,
+      0,
+      &multimeterProfileChar5Props
+    },
+
+      // Characteristic Value 5
+      {
+        { ATT_BT_UUID_SIZE, multimeterProfilechar5UUID },
+        GATT_PERMIT_READ | GATT_PERMIT_WRITE,
+        0,
+        multimeterProfileChar5
+      },
+
+      // Characteristic 5 User Description
+      {
+        { ATT_BT_UUID_SIZE, charUserDescUUID },
+        GATT_PERMIT_READ,
+        0,
+        multimeterProfileChar5UserDesp
+      },
+
+    // Characteristic 6 Declaration
+    {
+      { ATT_BT_UUID_SIZE, characterUUID },
+      GATT_PERMIT_READ,
+      0,
+      &multimeterProfileChar6Props
+    },
+
+      // Characteristic Value 6, read through multimeterProfileChar6
+      {
+        { ATT_BT_UUID_SIZE, multimeterProfilechar6UUID },
+        GATT_PERMIT_READ,
+        0,
+        (uint8 *)&multimeterProfileChar6
+      },
+
+      // Characteristic 6 User Description
+      {
+        { ATT_BT_UUID_SIZE, charUserDescUUID },
+        GATT_PERMIT_READ,
+        0,
+        multimeterProfileChar6UserDesp
+      },
+
+    // Characteristic 7 Declaration
+    {
+      { ATT_BT_UUID_SIZE, characterUUID },
+      GATT_PERMIT_READ,
+      0,
+      &multimeterProfileChar7Props
+    },
+
+      // Characteristic Value 7
+      {
+        { ATT_BT_UUID_SIZE, multimeterProfilechar7UUID },
+        GATT_PERMIT_READ | GATT_PERMIT_WRITE,
+        0,
+        multimeterProfileChar7
+      },
+
+      // Characteristic 7 User Description
+      {
+        { ATT_BT_UUID_SIZE, charUserDescUUID },
+        GATT_PERMIT_READ,
+        0,
+        multimeterProfileChar7UserDesp
+      },
+
+    // Characteristic 8 Declaration
+    {
+      { ATT_BT_UUID_SIZE, characterUUID },
+      GATT_PERMIT_READ,
+      0,
+      &multimeterProfileChar8Props
+    },
+
+      // Characteristic Value 8
+      {
+        { ATT_BT_UUID_SIZE, multimeterProfilechar8UUID },
+        GATT_PERMIT_READ | GATT_PERMIT_WRITE,
+        0,
+        multimeterProfileChar8
+      },
+
+      // Characteristic 8 User Description
+      {
+        { ATT_BT_UUID_SIZE, charUserDescUUID },
+        GATT_PERMIT_READ,
+        0,
+        multimeterProfileChar8UserDesp
+      },
+
+    // Characteristic 9 Declaration
+    {
+      { ATT_BT_UUID_SIZE, characterUUID },
+      GATT_PERMIT_READ,
+      0,
+      &multimeterProfileChar9Props
+    },
+
+      // Characteristic Value 9
+      {
+        { ATT_BT_UUID_SIZE, multimeterProfilechar9UUID },
+        GATT_PERMIT_READ,
+        0,
+        multimeterProfileChar9
+      },
+
+      // Characteristic 9 User Description
+      {
+        { ATT_BT_UUID_SIZE, charUserDescUUID },
+        GATT_PERMIT_READ,
+        0,
+        multimeterProfileChar9UserDesp
+      },
+
+    // Characteristic 10 Declaration
+    {
+      { ATT_BT_UUID_SIZE, characterUUID },
+      GATT_PERMIT_READ,
+      0,
+      &multimeterProfileChar10Props
+    },
+
+      // Characteristic Value 10
+      {
+        { ATT_BT_UUID_SIZE, multimeterProfilechar10UUID },
+        GATT_PERMIT_READ | GATT_PERMIT_WRITE,
+        0,
+        multimeterProfileChar10
+      },
+
+      // Characteristic 10 User Description
+      {
+        { ATT_BT_UUID_SIZE, charUserDescUUID },
+        GATT_PERMIT_READ,
+        0,
+        multimeterProfileChar10UserDesp
+      },
+
+    // Characteristic 11 Declaration
+    {
+      { ATT_BT_UUID_SIZE, characterUUID },
+      GATT_PERMIT_READ,
+      0,
+      &multimeterProfileChar11Props
+    },
+
+      // Characteristic Value 11
+      {
+        { ATT_BT_UUID_SIZE, multimeterProfilechar11UUID },
+        GATT_PERMIT_READ | GATT_PERMIT_WRITE,
+        0,
+        multimeterProfileChar11
+      },
+
+      // Characteristic 11 User Description
+      {
+        { ATT_BT_UUID_SIZE, charUserDescUUID },
+        GATT_PERMIT_READ,
+        0,
+        multimeterProfileChar11UserDesp
+      },
+
+    // Characteristic 12 Declaration
+    {
+      { ATT_BT_UUID_SIZE, characterUUID },
+      GATT_PERMIT_READ,
+      0,
+      &multimeterProfileChar12Props
+    },
+
+      // Characteristic Value 12, read through multimeterProfileChar12
+      {
+        { ATT_BT_UUID_SIZE, multimeterProfilechar12UUID },
+        GATT_PERMIT_READ,
+        0,
+        (uint8 *)&multimeterProfileChar12
+      },
+
+      // Characteristic 12 User Description
+      {
+        { ATT_BT_UUID_SIZE, charUserDescUUID },
+        GATT_PERMIT_READ,
+        0,
+        multimeterProfileChar12UserDesp
+      },
+
+    // Characteristic 13 Declaration
+    {
+      { ATT_BT_UUID_SIZE, characterUUID },
+      GATT_PERMIT_READ,
+      0,
+      &multimeterProfileChar13Props
+    },
+
+      // Characteristic Value 13
+      {
+        { ATT_BT_UUID_SIZE, multimeterProfilechar13UUID },
+        GATT_PERMIT_READ | GATT_PERMIT_WRITE,
+        0,
+        multimeterProfileChar13
+      },
+
+      // Characteristic 13 User Description
+      {
+        { ATT_BT_UUID_SIZE, charUserDescUUID },
+        GATT_PERMIT_READ,
+        0,
+        multimeterProfileChar13UserDesp
+      },
 };
 
 /*********************************************************************
@@ -226,6 +668,12 @@ static bStatus_t multimeterProfile_WriteAttrCB(uint16_t connHandle,
                                            gattAttribute_t *pAttr,
                                            uint8_t *pValue, uint16_t len,
                                            uint16_t offset, uint8_t method);
+static bStatus_t multimeterProfile_ReadLong(const uint8 *pSrc, uint16 srcLen,
+                                            uint8_t *pValue, uint16_t *pLen,
+                                            uint16_t offset, uint16_t maxLen);
+static bStatus_t multimeterProfile_WriteLong(uint8 *pDst, uint16 dstLen,
+                                             const uint8_t *pValue, uint16_t len,
+                                             uint16_t offset, uint8_t method);
 
 /*********************************************************************
  * PROFILE CALLBACKS
@@ -317,49 +765,184 @@ bStatus_t MultimeterProfile_RegisterAppCBs( multimeterProfileCBs_t *appCallbacks
 }
 
 /*********************************************************************
- * @fn      MultimeterProfile_SetParameter
+ * @fn      MultimeterProfile_SetParameter
+ *
+ * @brief   Set a Multimeter Profile parameter.
+ *
+ * @param   param - Profile parameter ID
+ * @param   len - length of data to write
+ * @param   value - pointer to data to write.  This is dependent on
+ *          the parameter ID and WILL be cast to the appropriate
+ *          data type (example: data type of uint16 will be cast to
+ *          uint16 pointer).
+ *
+ * @return  bStatus_t
+ */
+bStatus_t MultimeterProfile_SetParameter( uint8 param, uint8 len, void *value )
+{
+  bStatus_t ret = SUCCESS;
+  switch ( param )
+  {
+    case MULTIMETERPROFILE_CHAR1:
+      if ( len == sizeof ( uint8 ) )
+      {
+        multimeterProfileChar1 = *((uint8*)value);
+      }
+      else
+      {
+        ret = bleInvalidRange;
+      }
+      break;
+
+    case MULTIMETERPROFILE_CHAR2:
+      if ( len == MULTIMETERPROFILE_CHAR2_LEN )
+      {
+        VOID memcpy( multimeterProfileChar2, value, MULTIMETERPROFILE_CHAR2_LEN );
+      }
+      else
+      {
+        ret = bleInvalidRange;
+      }
+      break;
+
+    case MULTIMETERPROFILE_CHAR3:
+      if ( len == MULTIMETERPROFILE_CHAR3_LEN )
+      {
+        VOID memcpy( multimeterProfileChar3, value, MULTIMETERPROFILE_CHAR3_LEN );
+      }
+      else
+      {
+        ret = bleInvalidRange;
+      }
+      break;
+
+    case MULTIMETERPROFILE_CHAR4:
+      if ( len == MULTIMETERPROFILE_CHAR4_LEN )
+      {
+        VOID memcpy( multimeterProfileChar4, value, MULTIMETERPROFILE_CHAR4_LEN );
+
+        // See if Notification has been enabled
+        GATTServApp_ProcessCharCfg( multimeterProfileChar4Config, multimeterProfileChar4, FALSE,
+                                    multimeterProfileAttrTbl, GATT_NUM_ATTRS( multimeterProfileAttrTbl ),
+                                    INVALID_TASK_ID, multimeterProfile_ReadAttrCB );
+      }
+      else
+      {
+        ret = bleInvalidRange;
+      }
+      break;
+
+    case MULTIMETERPROFILE_CHAR5:
+      if ( len == MULTIMETERPROFILE_CHAR5_LEN )
+      {
+        VOID memcpy( multimeterProfileChar5, value, MULTIMETERPROFILE_CHAR5_LEN );
+      }
+      else
+      {
+        ret = bleInvalidRange;
+      }
+      break;
+
+    case MULTIMETERPROFILE_CHAR7:
+      if ( len == MULTIMETERPROFILE_CHAR7_LEN )
+      {
+        VOID memcpy( multimeterProfileChar7, value, MULTIMETERPROFILE_CHAR7_LEN );
+      }
+      else
+      {
+        ret = bleInvalidRange;
+      }
+      break;
+
+    case MULTIMETERPROFILE_CHAR8:
+      if ( len == MULTIMETERPROFILE_CHAR8_LEN )
+      {
+        VOID memcpy( multimeterProfileChar8, value, MULTIMETERPROFILE_CHAR8_LEN );
+      }
+      else
+      {
+        ret = bleInvalidRange;
+      }
+      break;
+
+    case MULTIMETERPROFILE_CHAR9:
+      if ( len == MULTIMETERPROFILE_CHAR9_LEN )
+      {
+        VOID memcpy( multimeterProfileChar9, value, MULTIMETERPROFILE_CHAR9_LEN );
+      }
+      else
+      {
+        ret = bleInvalidRange;
+      }
+      break;
+
+    case MULTIMETERPROFILE_CHAR10:
+      if ( len == MULTIMETERPROFILE_CHAR10_LEN )
+      {
+        VOID memcpy( multimeterProfileChar10, value, MULTIMETERPROFILE_CHAR10_LEN );
+      }
+      else
+      {
+        ret = bleInvalidRange;
+      }
+      break;
+
+    case MULTIMETERPROFILE_CHAR11:
+      if ( len == MULTIMETERPROFILE_CHAR11_LEN )
+      {
+        VOID memcpy( multimeterProfileChar11, value, MULTIMETERPROFILE_CHAR11_LEN );
+      }
+      else
+      {
+        ret = bleInvalidRange;
+      }
+      break;
+
+    case MULTIMETERPROFILE_CHAR13:
+      if ( len == MULTIMETERPROFILE_CHAR13_LEN )
+      {
+        VOID memcpy( multimeterProfileChar13, value, MULTIMETERPROFILE_CHAR13_LEN );
+      }
+      else
+      {
+        ret = bleInvalidRange;
+      }
+      break;
+
+    default:
+      ret = INVALIDPARAMETER;
+      break;
+  }
+
+  return ( ret );
+}
+
+/*********************************************************************
+ * @fn      MultimeterProfile_SetLongParameter
  *
- * @brief   Set a Multimeter Profile parameter.
+ * @brief   Set a long Multimeter Profile parameter. Long values are
+ *          read in place, the caller keeps them valid until they are
+ *          replaced.
  *
  * @param   param - Profile parameter ID
- * @param   len - length of data to write
- * @param   value - pointer to data to write.  This is dependent on
- *          the parameter ID and WILL be cast to the appropriate
- *          data type (example: data type of uint16 will be cast to
- *          uint16 pointer).
+ * @param   len - length of the value in bytes
+ * @param   value - pointer to the value, NULL for an empty value
  *
  * @return  bStatus_t
  */
-bStatus_t MultimeterProfile_SetParameter( uint8 param, uint8 len, void *value )
+bStatus_t MultimeterProfile_SetLongParameter( uint8 param, uint16 len, const uint8 *value )
 {
   bStatus_t ret = SUCCESS;
   switch ( param )
   {
-    case MULTIMETERPROFILE_CHAR1:
-      if ( len == sizeof ( uint8 ) )
-      {
-        multimeterProfileChar1 = *((uint8*)value);
-      }
-      else
-      {
-        ret = bleInvalidRange;
-      }
+    case MULTIMETERPROFILE_CHAR6:
+      multimeterProfileChar6 = value;
+      multimeterProfileChar6Len = ( value != NULL ) ? len : 0;
       break;
 
-    case MULTIMETERPROFILE_CHAR4:
-      if ( len == MULTIMETERPROFILE_CHAR4_LEN )
-      {
-        VOID memcpy( multimeterProfileChar4, value, MULTIMETERPROFILE_CHAR4_LEN );
-
-        // See if Notification has been enabled
-        GATTServApp_ProcessCharCfg( multimeterProfileChar4Config, multimeterProfileChar4, FALSE,
-                                    multimeterProfileAttrTbl, GATT_NUM_ATTRS( multimeterProfileAttrTbl ),
-                                    INVALID_TASK_ID, multimeterProfile_ReadAttrCB );
-      }
-      else
-      {
-        ret = bleInvalidRange;
-      }
+    case MULTIMETERPROFILE_CHAR12:
+      multimeterProfileChar12 = value;
+      multimeterProfileChar12Len = ( value != NULL ) ? len : 0;
       break;
 
     default:
@@ -392,10 +975,46 @@ bStatus_t MultimeterProfile_GetParameter( uint8 param, void *value )
       *((uint8*)value) = multimeterProfileChar1;
       break;
 
+    case MULTIMETERPROFILE_CHAR2:
+      VOID memcpy( value, multimeterProfileChar2, MULTIMETERPROFILE_CHAR2_LEN );
+      break;
+
+    case MULTIMETERPROFILE_CHAR3:
+      VOID memcpy( value, multimeterProfileChar3, MULTIMETERPROFILE_CHAR3_LEN );
+      break;
+
     case MULTIMETERPROFILE_CHAR4:
       VOID memcpy( value, multimeterProfileChar4, MULTIMETERPROFILE_CHAR4_LEN );
       break;
 
+    case MULTIMETERPROFILE_CHAR5:
+      VOID memcpy( value, multimeterProfileChar5, MULTIMETERPROFILE_CHAR5_LEN );
+      break;
+
+    case MULTIMETERPROFILE_CHAR7:
+      VOID memcpy( value, multimeterProfileChar7, MULTIMETERPROFILE_CHAR7_LEN );
+      break;
+
+    case MULTIMETERPROFILE_CHAR8:
+      VOID memcpy( value, multimeterProfileChar8, MULTIMETERPROFILE_CHAR8_LEN );
+      break;
+
+    case MULTIMETERPROFILE_CHAR9:
+      VOID memcpy( value, multimeterProfileChar9, MULTIMETERPROFILE_CHAR9_LEN );
+      break;
+
+    case MULTIMETERPROFILE_CHAR10:
+      VOID memcpy( value, multimeterProfileChar10, MULTIMETERPROFILE_CHAR10_LEN );
+      break;
+
+    case MULTIMETERPROFILE_CHAR11:
+      VOID memcpy( value, multimeterProfileChar11, MULTIMETERPROFILE_CHAR11_LEN );
+      break;
+
+    case MULTIMETERPROFILE_CHAR13:
+      VOID memcpy( value, multimeterProfileChar13, MULTIMETERPROFILE_CHAR13_LEN );
+      break;
+
     default:
       ret = INVALIDPARAMETER;
       break;
@@ -427,16 +1046,22 @@ static bStatus_t multimeterProfile_ReadAttrCB(uint16_t connHandle,
 {
   bStatus_t status = SUCCESS;
 
-  // Make sure it's not a blob operation (no attributes in the profile are long)
-  if ( offset > 0 )
-  {
-    return ( ATT_ERR_ATTR_NOT_LONG );
-  }
-
   if ( pAttr->type.len == ATT_BT_UUID_SIZE )
   {
     // 16-bit UUID
     uint16 uuid = BUILD_UINT16( pAttr->type.uuid[0], pAttr->type.uuid[1]);
+
+    // Make sure it's not a blob operation (only characteristics 3, 6, 8,
+    // 9 and 12 are longer than a read response at the default MTU)
+    if ( ( offset > 0 ) && ( uuid != MULTIMETERPROFILE_CHAR3_UUID ) &&
+         ( uuid != MULTIMETERPROFILE_CHAR6_UUID ) &&
+         ( uuid != MULTIMETERPROFILE_CHAR8_UUID ) &&
+         ( uuid != MULTIMETERPROFILE_CHAR9_UUID ) &&
+         ( uuid != MULTIMETERPROFILE_CHAR12_UUID ) )
+    {
+      return ( ATT_ERR_ATTR_NOT_LONG );
+    }
+
     switch ( uuid )
     {
       // No need for "GATT_SERVICE_UUID" or "GATT_CLIENT_CHAR_CFG_UUID" cases;
@@ -448,6 +1073,16 @@ static bStatus_t multimeterProfile_ReadAttrCB(uint16_t connHandle,
         pValue[0] = *pAttr->pValue;
         break;
 
+      case MULTIMETERPROFILE_CHAR2_UUID:
+        *pLen = MULTIMETERPROFILE_CHAR2_LEN;
+        VOID memcpy( pValue, pAttr->pValue, MULTIMETERPROFILE_CHAR2_LEN );
+        break;
+
+      case MULTIMETERPROFILE_CHAR3_UUID:
+        status = multimeterProfile_ReadLong( pAttr->pValue, MULTIMETERPROFILE_CHAR3_LEN,
+                                             pValue, pLen, offset, maxLen );
+        break;
+
       // characteristic 4 does not have read permissions, but because it
       //   can be sent as a notification, it is included here
       case MULTIMETERPROFILE_CHAR4_UUID:
@@ -455,6 +1090,51 @@ static bStatus_t multimeterProfile_ReadAttrCB(uint16_t connHandle,
         VOID memcpy( pValue, pAttr->pValue, MULTIMETERPROFILE_CHAR4_LEN );
         break;
 
+      case MULTIMETERPROFILE_CHAR5_UUID:
+        *pLen = MULTIMETERPROFILE_CHAR5_LEN;
+        VOID memcpy( pValue, pAttr->pValue, MULTIMETERPROFILE_CHAR5_LEN );
+        break;
+
+      case MULTIMETERPROFILE_CHAR6_UUID:
+        status = multimeterProfile_ReadLong( multimeterProfileChar6, multimeterProfileChar6Len,
+                                             pValue, pLen, offset, maxLen );
+        break;
+
+      case MULTIMETERPROFILE_CHAR7_UUID:
+        *pLen = MULTIMETERPROFILE_CHAR7_LEN;
+        VOID memcpy( pValue, pAttr->pValue, MULTIMETERPROFILE_CHAR7_LEN );
+        break;
+
+      case MULTIMETERPROFILE_CHAR8_UUID:
+        status = multimeterProfile_ReadLong( pAttr->pValue, MULTIMETERPROFILE_CHAR8_LEN,
+                                             pValue, pLen, offset, maxLen );
+        break;
+
+      case MULTIMETERPROFILE_CHAR9_UUID:
+        status = multimeterProfile_ReadLong( pAttr->pValue, MULTIMETERPROFILE_CHAR9_LEN,
+                                             pValue, pLen, offset, maxLen );
+        break;
+
+      case MULTIMETERPROFILE_CHAR10_UUID:
+        *pLen = MULTIMETERPROFILE_CHAR10_LEN;
+        VOID memcpy( pValue, pAttr->pValue, MULTIMETERPROFILE_CHAR10_LEN );
+        break;
+
+      case MULTIMETERPROFILE_CHAR11_UUID:
+        *pLen = MULTIMETERPROFILE_CHAR11_LEN;
+        VOID memcpy( pValue, pAttr->pValue, MULTIMETERPROFILE_CHAR11_LEN );
+        break;
+
+      case MULTIMETERPROFILE_CHAR13_UUID:
+        *pLen = MULTIMETERPROFILE_CHAR13_LEN;
+        VOID memcpy( pValue, pAttr->pValue, MULTIMETERPROFILE_CHAR13_LEN );
+        break;
+
+      case MULTIMETERPROFILE_CHAR12_UUID:
+        status = multimeterProfile_ReadLong( multimeterProfileChar12, multimeterProfileChar12Len,
+                                             pValue, pLen, offset, maxLen );
+        break;
+
       default:
         // Should never get here! (no other characteristics)
         *pLen = 0;
@@ -510,8 +1190,7 @@ static bStatus_t multimeterProfile_WriteAttrCB(uint16_t connHandle,
           {
             status = ATT_ERR_INVALID_VALUE_SIZE;
           }
-          //only values 0 to 4 are currently supported
-          else if (pValue[0] > 4)
+          else if (pValue[0] >= MultimeterMode_Count)
           {
             status = ATT_ERR_INVALID_VALUE;
           }
@@ -535,6 +1214,191 @@ static bStatus_t multimeterProfile_WriteAttrCB(uint16_t connHandle,
 
         break;
 
+      case MULTIMETERPROFILE_CHAR2_UUID:
+
+        //Validate and write the value, one byte longer than a write
+        // request at the default MTU so it also comes through a long write
+        status = multimeterProfile_WriteLong( pAttr->pValue, MULTIMETERPROFILE_CHAR2_LEN,
+                                              pValue, len, offset, method );
+
+        //Ranges are checked by the application once the value is complete
+        if ( ( status == SUCCESS ) && ( offset + len == MULTIMETERPROFILE_CHAR2_LEN ) )
+        {
+          if( pAttr->pValue == multimeterProfileChar2 )
+          {
+            notifyApp = MULTIMETERPROFILE_CHAR2;
+          }
+        }
+
+        break;
+
+      case MULTIMETERPROFILE_CHAR5_UUID:
+
+        //Validate the value
+        // Make sure it's not a blob oper
+        if ( offset == 0 )
+        {
+          if ( len != MULTIMETERPROFILE_CHAR5_LEN )
+          {
+            status = ATT_ERR_INVALID_VALUE_SIZE;
+          }
+        }
+        else
+        {
+          status = ATT_ERR_ATTR_NOT_LONG;
+        }
+
+        //Write the value, ranges are checked by the application
+        if ( status == SUCCESS )
+        {
+          VOID memcpy( pAttr->pValue, pValue, MULTIMETERPROFILE_CHAR5_LEN );
+
+          if( pAttr->pValue == multimeterProfileChar5 )
+          {
+            notifyApp = MULTIMETERPROFILE_CHAR5;
+          }
+        }
+
+        break;
+
+      case MULTIMETERPROFILE_CHAR7_UUID:
+
+        //Validate the command, the statistics themselves are read only
+        // Make sure it's not a blob oper
+        if ( offset == 0 )
+        {
+          if ( len != 1 )
+          {
+            status = ATT_ERR_INVALID_VALUE_SIZE;
+          }
+          else if ( pValue[0] != MULTIMETERPROFILE_CHAR7_RESET )
+          {
+            status = ATT_ERR_INVALID_VALUE;
+          }
+        }
+        else
+        {
+          status = ATT_ERR_ATTR_NOT_LONG;
+        }
+
+        //Leave the value to the application, it clears and rewrites it
+        if ( status == SUCCESS )
+        {
+          if( pAttr->pValue == multimeterProfileChar7 )
+          {
+            notifyApp = MULTIMETERPROFILE_CHAR7;
+          }
+        }
+
+        break;
+
+      case MULTIMETERPROFILE_CHAR8_UUID:
+
+        //Validate and write the value, longer than a write request at the
+        // default MTU so it also comes in parts through a long write
+        status = multimeterProfile_WriteLong( pAttr->pValue, MULTIMETERPROFILE_CHAR8_LEN,
+                                              pValue, len, offset, method );
+
+        //Ranges are checked by the application once the value is complete
+        if ( ( status == SUCCESS ) && ( offset + len == MULTIMETERPROFILE_CHAR8_LEN ) )
+        {
+          if( pAttr->pValue == multimeterProfileChar8 )
+          {
+            notifyApp = MULTIMETERPROFILE_CHAR8;
+          }
+        }
+
+        break;
+
+      case MULTIMETERPROFILE_CHAR10_UUID:
+
+        //Validate the command, the totals themselves are read only
+        // Make sure it's not a blob oper
+        if ( offset == 0 )
+        {
+          if ( len != 1 )
+          {
+            status = ATT_ERR_INVALID_VALUE_SIZE;
+          }
+          else if ( pValue[0] != MULTIMETERPROFILE_CHAR10_RESET )
+          {
+            status = ATT_ERR_INVALID_VALUE;
+          }
+        }
+        else
+        {
+          status = ATT_ERR_ATTR_NOT_LONG;
+        }
+
+        //Leave the value to the application, it clears and rewrites it
+        if ( status == SUCCESS )
+        {
+          if( pAttr->pValue == multimeterProfileChar10 )
+          {
+            notifyApp = MULTIMETERPROFILE_CHAR10;
+          }
+        }
+
+        break;
+
+      case MULTIMETERPROFILE_CHAR11_UUID:
+
+        //Validate the value
+        // Make sure it's not a blob oper
+        if ( offset == 0 )
+        {
+          if ( len != MULTIMETERPROFILE_CHAR11_LEN )
+          {
+            status = ATT_ERR_INVALID_VALUE_SIZE;
+          }
+        }
+        else
+        {
+          status = ATT_ERR_ATTR_NOT_LONG;
+        }
+
+        //Write the value, ranges are checked by the application
+        if ( status == SUCCESS )
+        {
+          VOID memcpy( pAttr->pValue, pValue, MULTIMETERPROFILE_CHAR11_LEN );
+
+          if( pAttr->pValue == multimeterProfileChar11 )
+          {
+            notifyApp = MULTIMETERPROFILE_CHAR11;
+          }
+        }
+
+        break;
+
+      case MULTIMETERPROFILE_CHAR13_UUID:
+
+        //Validate the value
+        // Make sure it's not a blob oper
+        if ( offset == 0 )
+        {
+          if ( len != MULTIMETERPROFILE_CHAR13_LEN )
+          {
+            status = ATT_ERR_INVALID_VALUE_SIZE;
+          }
+        }
+        else
+        {
+          status = ATT_ERR_ATTR_NOT_LONG;
+        }
+
+        //Write the value, the table is checked by the application
+        if ( status == SUCCESS )
+        {
+          VOID memcpy( pAttr->pValue, pValue, MULTIMETERPROFILE_CHAR13_LEN );
+
+          if( pAttr->pValue == multimeterProfileChar13 )
+          {
+            notifyApp = MULTIMETERPROFILE_CHAR13;
+          }
+        }
+
+        break;
+
       case GATT_CLIENT_CHAR_CFG_UUID:
         status = GATTServApp_ProcessCCCWriteReq( connHandle, pAttr, pValue, len,
                                                  offset, GATT_CLIENT_CFG_NOTIFY );
@@ -561,5 +1425,81 @@ static bStatus_t multimeterProfile_WriteAttrCB(uint16_t connHandle,
   return ( status );
 }
 
+/*********************************************************************
+ * @fn      multimeterProfile_ReadLong
+ *
+ * @brief   Read the part of a long value from an offset on, as many
+ *          octets as fit in the response.
+ *
+ * @param   pSrc - value
+ * @param   srcLen - length of the value
+ * @param   pValue - pointer to data to be read
+ * @param   pLen - length of data to be read
+ * @param   offset - offset of the first octet to be read
+ * @param   maxLen - maximum length of data to be read
+ *
+ * @return  SUCCESS or ATT_ERR_INVALID_OFFSET
+ */
+static bStatus_t multimeterProfile_ReadLong(const uint8 *pSrc, uint16 srcLen,
+                                            uint8_t *pValue, uint16_t *pLen,
+                                            uint16_t offset, uint16_t maxLen)
+{
+  if ( offset > srcLen )
+  {
+    *pLen = 0;
+    return ( ATT_ERR_INVALID_OFFSET );
+  }
+
+  *pLen = MIN( maxLen, srcLen - offset );
+  if ( *pLen > 0 )
+  {
+    VOID memcpy( pValue, pSrc + offset, *pLen );
+  }
+
+  return ( SUCCESS );
+}
+
+/*********************************************************************
+ * @fn      multimeterProfile_WriteLong
+ *
+ * @brief   Write a fixed length value, whole in a write request or in
+ *          parts as the execute write of a long write hands them over.
+ *          The value is complete once a part ends at its length.
+ *
+ * @param   pDst - value
+ * @param   dstLen - length of the value
+ * @param   pValue - pointer to data to be written
+ * @param   len - length of data
+ * @param   offset - offset of the first octet to be written
+ * @param   method - type of write message
+ *
+ * @return  SUCCESS, ATT_ERR_INVALID_OFFSET or ATT_ERR_INVALID_VALUE_SIZE
+ */
+static bStatus_t multimeterProfile_WriteLong(uint8 *pDst, uint16 dstLen,
+                                             const uint8_t *pValue, uint16_t len,
+                                             uint16_t offset, uint8_t method)
+{
+  if ( method != ATT_EXECUTE_WRITE_REQ )
+  {
+    // A single write carries the whole value
+    if ( ( offset != 0 ) || ( len != dstLen ) )
+    {
+      return ( ATT_ERR_INVALID_VALUE_SIZE );
+    }
+  }
+  else if ( offset > dstLen )
+  {
+    return ( ATT_ERR_INVALID_OFFSET );
+  }
+  else if ( len > dstLen - offset )
+  {
+    return ( ATT_ERR_INVALID_VALUE_SIZE );
+  }
+
+  VOID memcpy( pDst + offset, pValue, len );
+
+  return ( SUCCESS );
+}
+
 /*********************************************************************
 *********************************************************************/
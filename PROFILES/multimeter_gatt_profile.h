@@ -63,21 +63,68 @@ extern "C"
 
 // Profile Parameters
 #define MULTIMETERPROFILE_CHAR1                   0  // RW uint8 - Profile Characteristic 1 value
+#define MULTIMETERPROFILE_CHAR2                   1  // RW uint8 array - Profile Characteristic 2 value
+#define MULTIMETERPROFILE_CHAR3                   2  // R uint8 array - Profile Characteristic 3 value
 #define MULTIMETERPROFILE_CHAR4                   3  // RW uint8 - Profile Characteristic 4 value
+#define MULTIMETERPROFILE_CHAR5                   4  // RW uint8 array - Profile Characteristic 5 value
+#define MULTIMETERPROFILE_CHAR6                   5  // R long uint8 array - Profile Characteristic 6 value
+#define MULTIMETERPROFILE_CHAR7                   6  // RW uint8 array - Profile Characteristic 7 value
+#define MULTIMETERPROFILE_CHAR8                   7  // RW uint8 array - Profile Characteristic 8 value
+#define MULTIMETERPROFILE_CHAR9                   8  // R uint8 array - Profile Characteristic 9 value
+#define MULTIMETERPROFILE_CHAR10                  9  // RW uint8 array - Profile Characteristic 10 value
+#define MULTIMETERPROFILE_CHAR11                  10 // RW uint8 array - Profile Characteristic 11 value
+#define MULTIMETERPROFILE_CHAR12                  11 // R long uint8 array - Profile Characteristic 12 value
+#define MULTIMETERPROFILE_CHAR13                  12 // RW uint8 array - Profile Characteristic 13 value
 
 // Multimeter Service UUID
 #define MULTIMETER_SERV_UUID               0xFFF0
 
 // Key Pressed UUID
 #define MULTIMETERPROFILE_CHAR1_UUID            0xFFF1
+#define MULTIMETERPROFILE_CHAR2_UUID            0xFFF2
+#define MULTIMETERPROFILE_CHAR3_UUID            0xFFF3
 #define MULTIMETERPROFILE_CHAR4_UUID            0xFFF4
+#define MULTIMETERPROFILE_CHAR5_UUID            0xFFF5
+#define MULTIMETERPROFILE_CHAR6_UUID            0xFFF6
+#define MULTIMETERPROFILE_CHAR7_UUID            0xFFF7
+#define MULTIMETERPROFILE_CHAR8_UUID            0xFFF8
+#define MULTIMETERPROFILE_CHAR9_UUID            0xFFF9
+#define MULTIMETERPROFILE_CHAR10_UUID           0xFFFA
+#define MULTIMETERPROFILE_CHAR11_UUID           0xFFFB
+#define MULTIMETERPROFILE_CHAR12_UUID           0xFFFC
+#define MULTIMETERPROFILE_CHAR13_UUID           0xFFFD
 
 // Multimeter Keys Profile Services bit fields
 #define MULTIMETER_SERVICE               0x00000001
 
+// Length of Characteristic 2 in bytes
+#define MULTIMETERPROFILE_CHAR2_LEN           21
+
+// Length of Characteristic 3 in bytes
+#define MULTIMETERPROFILE_CHAR3_LEN           39
+
 // Length of Characteristic 4 in bytes
 #define MULTIMETERPROFILE_CHAR4_LEN           4
 
+// Length of Characteristic 5 in bytes
+#define MULTIMETERPROFILE_CHAR5_LEN           11
+
+// Length of Characteristic 7 in bytes
+#define MULTIMETERPROFILE_CHAR7_LEN           20
+
+// Length of Characteristics 8 and 9 in bytes
+#define MULTIMETERPROFILE_CHAR8_LEN           32
+#define MULTIMETERPROFILE_CHAR9_LEN           32
+
+// Length of Characteristic 10 in bytes
+#define MULTIMETERPROFILE_CHAR10_LEN          16
+
+// Length of Characteristic 11 in bytes
+#define MULTIMETERPROFILE_CHAR11_LEN          6
+
+// Length of Characteristic 13 in bytes
+#define MULTIMETERPROFILE_CHAR13_LEN          10
+
 /*********************************************************************
  * TYPEDEFS
  */
@@ -91,9 +138,226 @@ typedef enum MultimeterMode {
     MultimeterMode_3V,
     MultimeterMode_10V,
     MultimeterMode_500mA,
-    MultimeterMode_Ohm
+    MultimeterMode_Ohm,         // Reading in mOhm, 0xFFFFFFFF open or beyond the top range
+    MultimeterMode_10VAC,
+    MultimeterMode_500mAAC,
+    MultimeterMode_Frequency,   // Reading in mHz, on the 3V input
+    MultimeterMode_Period,      // Reading in ns, 0xFFFFFFFF without a signal
+    MultimeterMode_DutyCycle,   // Reading in ppm, 0xFFFFFFFF without a signal
+    MultimeterMode_AutoV,       // Reading in uV, switches between the 3V and 10V ranges
+    MultimeterMode_Continuity,  // Reading in mOhm, 0xFFFFFFFF while open, notified on every change
+    MultimeterMode_Diode,       // Forward voltage in uV, 0xFFFFFFFF while open, notified on every change
+
+    MultimeterMode_Count
 } MultimeterMode;
 
+/*
+ * Characteristic 2 (acquisition configuration) layout, all fields big endian.
+ * It is one byte longer than a write request at the default MTU and is
+ * written with a long (prepared) write unless the MTU was raised.
+ *
+ *  Offset  Size  Field
+ *  0       4     ADC sampling frequency in Hz
+ *  4       2     Samples per window, upper bound of an adaptive window
+ *  6       4     Reporting period in ms
+ *  10      1     Oversampling bits n, 0 to 4 (4^n samples per output,
+ *                12 + n bits of resolution)
+ *  11      1     Flags, see MULTIMETERPROFILE_CHAR2_FLAG_*
+ *  12      2     Lower bound of an adaptive window
+ *  14      4     Target noise of a reading in uV at the ADC input,
+ *                0 keeps the window fixed
+ *  18      1     Mains synchronisation: 0 off, 1 50 Hz, 2 60 Hz, 3 auto.
+ *                Windows then span whole mains cycles and the reading is
+ *                their mean
+ *  19      1     Reducer of a window to a reading: 0 median (the mean
+ *                when mains synchronised), 1 trimmed mean, 2 Hampel
+ *                filtered mean, 3 exponential average across windows
+ *  20      1     Reducer parameter: percent trimmed at either end (0 to
+ *                49), outlier threshold in tenths of a sigma (1 to 255)
+ *                or time constant in 2^n windows (0 to 8)
+ */
+#define MULTIMETERPROFILE_CHAR2_FREQUENCY_OFFSET  0
+#define MULTIMETERPROFILE_CHAR2_WINDOW_OFFSET     4
+#define MULTIMETERPROFILE_CHAR2_PERIOD_OFFSET     6
+#define MULTIMETERPROFILE_CHAR2_OVERSAMPLING_OFFSET 10
+#define MULTIMETERPROFILE_CHAR2_FLAGS_OFFSET      11
+#define MULTIMETERPROFILE_CHAR2_MIN_WINDOW_OFFSET 12
+#define MULTIMETERPROFILE_CHAR2_NOISE_OFFSET      14
+#define MULTIMETERPROFILE_CHAR2_MAINS_OFFSET      18
+#define MULTIMETERPROFILE_CHAR2_REDUCER_OFFSET    19
+#define MULTIMETERPROFILE_CHAR2_REDUCER_PARAM_OFFSET 20
+
+// Scan VSS, DCOUPL and VDDS ahead of every window to track offset and supply
+#define MULTIMETERPROFILE_CHAR2_FLAG_REF_SCAN     0x01
+
+/*
+ * Characteristic 3 (status) layout, all fields big endian. It is longer
+ * than one ATT packet at the default MTU and is read with long (blob)
+ * reads.
+ *
+ *  Offset  Size  Field
+ *  0       4     Report sequence number, index of the report period the
+ *                last measurement belongs to
+ *  4       4     Report periods that were serviced after their deadline
+ *  8       4     Acquisition windows lost or overwritten
+ *  12      4     Acquisition windows dropped on a full descriptor ring
+ *  16      2     Samples per window currently acquired
+ *  18      1     Mains frequency the windows are synchronised to in Hz,
+ *                0 if none or still detecting
+ *  19      4     Continuity and diode modes: latency of the last change,
+ *                from its first sample to its notification, in usec
+ *  23      4     Continuity and diode modes: highest latency since the
+ *                mode was selected, in usec
+ *  27      4     Cost of the last mode or range switch, from the switch
+ *                to the end of its first window clean of the front end
+ *                transient, in usec
+ *  31      4     Highest switch cost since power up, in usec
+ *  35      4     Samples discarded while the front end settled since
+ *                power up
+ */
+#define MULTIMETERPROFILE_CHAR3_SEQUENCE_OFFSET       0
+#define MULTIMETERPROFILE_CHAR3_REPORT_OVERRUN_OFFSET 4
+#define MULTIMETERPROFILE_CHAR3_ACQ_OVERRUN_OFFSET    8
+#define MULTIMETERPROFILE_CHAR3_ACQ_OVERFLOW_OFFSET   12
+#define MULTIMETERPROFILE_CHAR3_WINDOW_OFFSET         16
+#define MULTIMETERPROFILE_CHAR3_MAINS_OFFSET          18
+#define MULTIMETERPROFILE_CHAR3_EDGE_LATENCY_OFFSET   19
+#define MULTIMETERPROFILE_CHAR3_MAX_LATENCY_OFFSET    23
+#define MULTIMETERPROFILE_CHAR3_SWITCH_COST_OFFSET    27
+#define MULTIMETERPROFILE_CHAR3_MAX_SWITCH_COST_OFFSET 31
+#define MULTIMETERPROFILE_CHAR3_SETTLE_DISCARDED_OFFSET 35
+
+/*
+ * Characteristic 5 (trigger) layout, all fields big endian. Writing it
+ * drops the capture and arms the trigger, the state is read only.
+ *
+ *  Offset  Size  Field
+ *  0       1     Trigger type: 0 off, 1 level, 2 edge, 3 window
+ *  1       1     Slope of the level and edge triggers: 0 rising, 1 falling
+ *  2       2     Trigger level, raw ADC code
+ *  4       2     Upper level of the window trigger, raw ADC code
+ *  6       2     Samples kept ahead of the trigger
+ *  8       2     Samples recorded from the trigger on
+ *  10      1     State: 0 idle, 1 armed, 2 triggered, 3 captured
+ *
+ * Characteristic 6 (capture) holds the frozen capture as big endian raw
+ * ADC codes, oldest first. It is longer than one ATT packet and is read
+ * with long (blob) reads.
+ */
+#define MULTIMETERPROFILE_CHAR5_TYPE_OFFSET       0
+#define MULTIMETERPROFILE_CHAR5_SLOPE_OFFSET      1
+#define MULTIMETERPROFILE_CHAR5_LEVEL_OFFSET      2
+#define MULTIMETERPROFILE_CHAR5_HIGH_LEVEL_OFFSET 4
+#define MULTIMETERPROFILE_CHAR5_PRE_OFFSET        6
+#define MULTIMETERPROFILE_CHAR5_POST_OFFSET       8
+#define MULTIMETERPROFILE_CHAR5_STATE_OFFSET      10
+
+/*
+ * Characteristic 7 (statistics) layout, all fields big endian. The values
+ * cover every raw sample since the last reset, converted with the scale
+ * of the current mode. Writing the single byte
+ * MULTIMETERPROFILE_CHAR7_RESET clears them, they are also cleared when
+ * the mode changes.
+ *
+ *  Offset  Size  Field
+ *  0       4     Number of samples
+ *  4       4     Mean (signed, uV or uA)
+ *  8       4     Standard deviation (uV or uA)
+ *  12      4     Lowest single sample, peak hold (signed, uV or uA)
+ *  16      4     Highest single sample, peak hold (signed, uV or uA)
+ */
+#define MULTIMETERPROFILE_CHAR7_COUNT_OFFSET      0
+#define MULTIMETERPROFILE_CHAR7_MEAN_OFFSET       4
+#define MULTIMETERPROFILE_CHAR7_STD_DEV_OFFSET    8
+#define MULTIMETERPROFILE_CHAR7_MIN_OFFSET        12
+#define MULTIMETERPROFILE_CHAR7_MAX_OFFSET        16
+
+// Characteristic 7 command clearing the statistics
+#define MULTIMETERPROFILE_CHAR7_RESET             0x01
+
+/*
+ * Characteristic 8 (spectrum bins) holds up to 8 frequencies in Hz as big
+ * endian uint32, the list ends at the first 0. Characteristic 9
+ * (spectrum) holds the peak amplitude of each bin in the latest window as
+ * big endian uint32 in uV or uA, 0 for unused bins and bins at or above
+ * half the sampling frequency. Both are longer than one ATT packet at the
+ * default MTU: they are read with long (blob) reads, and characteristic 8
+ * is written with a long (prepared) write unless the MTU was raised.
+ */
+#define MULTIMETERPROFILE_CHAR8_BIN_SIZE          4
+
+/*
+ * Characteristic 10 (charge) layout, all fields big endian. The totals
+ * integrate the mean current of each window in the 500mA and 500mAAC
+ * modes over the time since the previous window, the AC mode giving the
+ * net charge of its DC component. They are kept across mode changes and
+ * both modes keep counting while disconnected.
+ * The energy uses the latest 3V or 10V reading as the load voltage.
+ * Writing the single byte MULTIMETERPROFILE_CHAR10_RESET clears them.
+ *
+ *  Offset  Size  Field
+ *  0       4     Charge (signed, uAh)
+ *  4       4     Energy (signed, uWh), 0 without a voltage reading
+ *  8       4     Load voltage (signed, uV), 0 without a voltage reading
+ *  12      4     Integration time (s)
+ */
+#define MULTIMETERPROFILE_CHAR10_CHARGE_OFFSET    0
+#define MULTIMETERPROFILE_CHAR10_ENERGY_OFFSET    4
+#define MULTIMETERPROFILE_CHAR10_VOLTAGE_OFFSET   8
+#define MULTIMETERPROFILE_CHAR10_TIME_OFFSET      12
+
+// Characteristic 10 command clearing the totals
+#define MULTIMETERPROFILE_CHAR10_RESET            0x01
+
+/*
+ * Characteristic 11 (histogram setup) layout, all fields big endian. Bin
+ * i counts the raw ADC codes from first code + i * 2^width shift up to the
+ * next bin, one more bin counts the codes outside the range. A histogram
+ * is complete after the given number of windows, 0 turns it off. Out of
+ * range values are rejected and the setup in use is written back.
+ *
+ *  Offset  Size  Field
+ *  0       2     First code
+ *  2       1     Bin width shift, 0 to 12
+ *  3       1     Number of bins, 1 to 32
+ *  4       2     Windows per histogram
+ *
+ * Characteristic 12 (histogram) is read as a long value and holds the
+ * latest complete histogram: the setup it was built with (first code,
+ * width shift, bins, windows as above), then one big endian uint32 count
+ * per bin and a last one for the codes outside the range. It is empty
+ * until the first histogram completes.
+ */
+#define MULTIMETERPROFILE_CHAR11_FIRST_CODE_OFFSET 0
+#define MULTIMETERPROFILE_CHAR11_WIDTH_OFFSET     2
+#define MULTIMETERPROFILE_CHAR11_BINS_OFFSET      3
+#define MULTIMETERPROFILE_CHAR11_WINDOWS_OFFSET   4
+
+/*
+ * Characteristic 13 (calibration) layout, all fields big endian. A table
+ * maps nominal readings to calibrated ones in the unit of the mode, with
+ * strictly increasing inputs. It is sent one point per write: index 0
+ * starts a new table, the commit index checks it, stores it in SNV and
+ * puts it in use, the clear index removes the table of the mode. Reading
+ * back gives the last write with the index replaced by the number of
+ * points staged, or by the number of points in use after a commit or a
+ * clear. A rejected write reads back 0xFF in the mode field.
+ *
+ *  Offset  Size  Field
+ *  0       1     Mode
+ *  1       1     Point index, commit or clear
+ *  2       4     Nominal reading (int32)
+ *  6       4     Calibrated reading (int32)
+ */
+#define MULTIMETERPROFILE_CHAR13_MODE_OFFSET      0
+#define MULTIMETERPROFILE_CHAR13_INDEX_OFFSET     1
+#define MULTIMETERPROFILE_CHAR13_INPUT_OFFSET     2
+#define MULTIMETERPROFILE_CHAR13_OUTPUT_OFFSET    6
+
+// Characteristic 13 indices committing and clearing a table
+#define MULTIMETERPROFILE_CHAR13_COMMIT           0xFE
+#define MULTIMETERPROFILE_CHAR13_CLEAR            0xFF
+
 /*********************************************************************
  * MACROS
  */
@@ -158,6 +422,17 @@ extern bStatus_t MultimeterProfile_SetParameter( uint8 param, uint8 len, void *v
  */
 extern bStatus_t MultimeterProfile_GetParameter( uint8 param, void *value );
 
+/*
+ * MultimeterProfile_SetLongParameter - Set a long (read only) Multimeter
+ *          GATT Profile parameter. The value is not copied and must stay
+ *          valid until it is replaced.
+ *
+ *    param - Profile parameter ID
+ *    len - length of the value in bytes
+ *    value - pointer to the value, NULL for an empty value
+ */
+extern bStatus_t MultimeterProfile_SetLongParameter( uint8 param, uint16 len, const uint8 *value );
+
 
 /*********************************************************************
 *********************************************************************/
@@ -0,0 +1,197 @@
+/*
+ * Host benchmark of the window reducers. Every trace is cut into windows
+ * like the acquisition delivers them and reduced with the median, the
+ * trimmed mean, the Hampel-filtered mean and the exponential average
+ * across windows, each with its default parameter. For every reducer it
+ * reports the host time per sample and the spread of the readings, in
+ * codes, across the windows of the trace.
+ *
+ *   bench_reduce trace...
+ *
+ * A trace is a text file of raw 12-bit ADC codes separated by white
+ * space, lines starting with # are comments.
+ */
+#define _POSIX_C_SOURCE 199309L
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "multimeter_reduce.h"
+
+#define MAX_TRACE     65536
+
+// Passes over a trace, long enough for the clock to resolve the time
+#define REPEAT        50
+
+static const uint16_t windowSizes[] = { 100, 1024 };
+
+static uint16_t trace[MAX_TRACE];
+
+// One reading per window, in codes
+static double readings[MAX_TRACE];
+
+static long readTrace(const char *path)
+{
+  FILE *file = fopen(path, "r");
+  long count = 0;
+  unsigned int code;
+  int c;
+
+  if (file == NULL)
+  {
+    return -1;
+  }
+
+  while (count < MAX_TRACE)
+  {
+    if (fscanf(file, " %u", &code) == 1)
+    {
+      trace[count++] = (uint16_t)(code & 0xFFF);
+    }
+    else if ((c = fgetc(file)) == '#')
+    {
+      while ((c = fgetc(file)) != EOF && c != '\n')
+      {
+      }
+    }
+    else if (c == EOF)
+    {
+      break;
+    }
+  }
+
+  fclose(file);
+
+  return count;
+}
+
+static double now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Reading of one window in codes, the IIR average carries across windows
+static double reduce(MultimeterReduceType type, const uint16_t *samples, uint16_t count,
+                     int32_t *pAccumulator, bool *pValid)
+{
+  multimeterReduceStats_t stats;
+  int32_t mean;
+  uint32_t code;
+
+  switch (type)
+  {
+    case MultimeterReduceType_TrimmedMean:
+      code = MultimeterReduce_trimmedMean(samples, count, MULTIMETER_REDUCE_CODE_BITS,
+                                          MULTIMETER_REDUCE_DEFAULT_TRIM);
+      return (double)code / (1 << MULTIMETER_REDUCE_MEAN_FRAC_BITS);
+
+    case MultimeterReduceType_Hampel:
+      MultimeterReduce_window(samples, count, MULTIMETER_REDUCE_CODE_BITS, &stats);
+      code = MultimeterReduce_hampelMean(samples, count, MULTIMETER_REDUCE_CODE_BITS,
+                                         stats.median, MULTIMETER_REDUCE_DEFAULT_HAMPEL);
+      return (double)code / (1 << MULTIMETER_REDUCE_MEAN_FRAC_BITS);
+
+    case MultimeterReduceType_Iir:
+      MultimeterReduce_window(samples, count, MULTIMETER_REDUCE_CODE_BITS, &stats);
+      mean = (int32_t)(((stats.sum << MULTIMETER_REDUCE_MEAN_FRAC_BITS) + count / 2) / count);
+      mean = MultimeterReduce_iir(pAccumulator, *pValid, mean, MULTIMETER_REDUCE_DEFAULT_IIR_SHIFT);
+      *pValid = true;
+      return (double)mean / (1 << MULTIMETER_REDUCE_MEAN_FRAC_BITS);
+
+    default:
+      return MultimeterReduce_median(samples, count);
+  }
+}
+
+static void bench(const char *name, long length, uint16_t windowSize)
+{
+  static const char *names[] = { "median", "trimmed", "hampel", "iir" };
+  long windows = length / windowSize;
+  int32_t accumulator = 0;
+  bool valid;
+  double start;
+  double seconds;
+  double mean;
+  double spread;
+  int type;
+  int pass;
+  long i;
+
+  if (windows < 2)
+  {
+    return;
+  }
+
+  for (type = 0; type < MultimeterReduceType_Count; type++)
+  {
+    start = now();
+    for (pass = 0; pass < REPEAT; pass++)
+    {
+      valid = false;
+      for (i = 0; i < windows; i++)
+      {
+        readings[i] = reduce((MultimeterReduceType)type, trace + i * windowSize, windowSize,
+                             &accumulator, &valid);
+      }
+    }
+    seconds = (now() - start) / REPEAT;
+
+    mean = 0;
+    for (i = 0; i < windows; i++)
+    {
+      mean += readings[i];
+    }
+    mean /= windows;
+    spread = 0;
+    for (i = 0; i < windows; i++)
+    {
+      spread += (readings[i] - mean) * (readings[i] - mean);
+    }
+    spread = sqrt(spread / (windows - 1));
+
+    printf("%-16s n=%-5u %-8s %7.2f ns/sample  mean %8.2f  spread %7.3f codes\n",
+           name, windowSize, names[type], seconds * 1e9 / (windows * windowSize),
+           mean, spread);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  const char *name;
+  const char *p;
+  long length;
+  unsigned int i;
+  int arg;
+
+  for (arg = 1; arg < argc; arg++)
+  {
+    length = readTrace(argv[arg]);
+    if (length < 0)
+    {
+      fprintf(stderr, "%s: cannot read\n", argv[arg]);
+      return 1;
+    }
+
+    // Trace name without its directory
+    for (name = p = argv[arg]; *p != '\0'; p++)
+    {
+      if (*p == '/')
+      {
+        name = p + 1;
+      }
+    }
+
+    for (i = 0; i < sizeof(windowSizes) / sizeof(windowSizes[0]); i++)
+    {
+      bench(name, length, windowSizes[i]);
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,153 @@
+/*
+ * Simulated ADCBuf driver and SYS/BIOS clock for the host tests.
+ */
+#include <string.h>
+
+#include <ti/sysbios/knl/Clock.h>
+
+#include "fake_adcbuf.h"
+
+fakeAdcBuf_t fakeAdcBuf;
+uint32_t fakeClockTicks = 0;
+uint32_t Clock_tickPeriod = 10;
+
+static struct ADCBuf_Config_ { int unused; } fakeAdcBufConfig;
+
+uint32_t Clock_getTicks(void)
+{
+  return (fakeClockTicks);
+}
+
+void FakeAdcBuf_reset(void)
+{
+  memset(&fakeAdcBuf, 0, sizeof(fakeAdcBuf));
+}
+
+void *FakeAdcBuf_complete(uint16_t code)
+{
+  ADCBuf_Conversion *pConversion = fakeAdcBuf.pConversion;
+  uint16_t *pBuffer;
+  uint16_t i;
+
+  if (!fakeAdcBuf.running)
+  {
+    return (NULL);
+  }
+
+  pBuffer = (fakeAdcBuf.fill == 0) ? pConversion->sampleBuffer : pConversion->sampleBufferTwo;
+  for (i = 0; i < pConversion->samplesRequestedCount; i++)
+  {
+    pBuffer[i] = code;
+  }
+
+  if (fakeAdcBuf.params.recurrenceMode == ADCBuf_RECURRENCE_MODE_CONTINUOUS)
+  {
+    // DMA moves on to the other buffer before the callback runs
+    fakeAdcBuf.fill ^= 1;
+  }
+  else
+  {
+    fakeAdcBuf.running = false;
+  }
+
+  fakeAdcBuf.params.callbackFxn(&fakeAdcBufConfig, pConversion, pBuffer,
+                                pConversion->adcChannel);
+
+  return (pBuffer);
+}
+
+void ADCBuf_init(void)
+{
+}
+
+void ADCBuf_Params_init(ADCBuf_Params *params)
+{
+  memset(params, 0, sizeof(*params));
+  params->samplingFrequency = 10000;
+  params->returnMode = ADCBuf_RETURN_MODE_BLOCKING;
+  params->recurrenceMode = ADCBuf_RECURRENCE_MODE_ONE_SHOT;
+}
+
+ADCBuf_Handle ADCBuf_open(uint_least8_t index, ADCBuf_Params *params)
+{
+  (void)index;
+
+  if (fakeAdcBuf.open)
+  {
+    return (NULL);
+  }
+
+  fakeAdcBuf.open = true;
+  fakeAdcBuf.openCount++;
+  fakeAdcBuf.params = *params;
+
+  return (&fakeAdcBufConfig);
+}
+
+void ADCBuf_close(ADCBuf_Handle handle)
+{
+  (void)handle;
+
+  fakeAdcBuf.open = false;
+  fakeAdcBuf.running = false;
+  fakeAdcBuf.closeCount++;
+}
+
+int_fast16_t ADCBuf_convert(ADCBuf_Handle handle, ADCBuf_Conversion conversions[],
+                            uint_fast8_t channelCount)
+{
+  (void)handle;
+  (void)channelCount;
+
+  if (!fakeAdcBuf.open || fakeAdcBuf.running)
+  {
+    return (ADCBuf_STATUS_ERROR);
+  }
+
+  fakeAdcBuf.running = true;
+  fakeAdcBuf.fill = 0;
+  fakeAdcBuf.convertCount++;
+  fakeAdcBuf.pConversion = &conversions[0];
+
+  return (ADCBuf_STATUS_SUCCESS);
+}
+
+int_fast16_t ADCBuf_convertCancel(ADCBuf_Handle handle)
+{
+  (void)handle;
+
+  fakeAdcBuf.running = false;
+  fakeAdcBuf.cancelCount++;
+
+  return (ADCBuf_STATUS_SUCCESS);
+}
+
+int_fast16_t ADCBuf_adjustRawValues(ADCBuf_Handle handle, void *sampleBuffer,
+                                    uint_fast16_t sampleCount, uint32_t adcChannel)
+{
+  (void)handle;
+  (void)sampleBuffer;
+  (void)sampleCount;
+  (void)adcChannel;
+
+  return (ADCBuf_STATUS_SUCCESS);
+}
+
+int_fast16_t ADCBuf_convertAdjustedToMicroVolts(ADCBuf_Handle handle, uint32_t adcChannel,
+                                                void *adjustedSampleBuffer,
+                                                uint32_t outputMicroVoltBuffer[],
+                                                uint_fast16_t sampleCount)
+{
+  uint16_t *pCodes = adjustedSampleBuffer;
+  uint_fast16_t i;
+
+  (void)handle;
+  (void)adcChannel;
+
+  for (i = 0; i < sampleCount; i++)
+  {
+    outputMicroVoltBuffer[i] = (uint32_t)pCodes[i] * FAKE_ADCBUF_MICROVOLT_PER_CODE;
+  }
+
+  return (ADCBuf_STATUS_SUCCESS);
+}
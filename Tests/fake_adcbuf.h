@@ -0,0 +1,41 @@
+/*
+ * Simulated ADCBuf driver for the host tests. Conversions complete when a
+ * test calls FakeAdcBuf_complete, which fills the buffer being converted
+ * and calls the driver callback like the driver SWI would.
+ */
+#ifndef FAKE_ADCBUF_H
+#define FAKE_ADCBUF_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <ti/drivers/ADCBuf.h>
+
+// Voltage of one code returned by ADCBuf_convertAdjustedToMicroVolts
+#define FAKE_ADCBUF_MICROVOLT_PER_CODE  1000
+
+typedef struct
+{
+  bool          open;
+  bool          running;
+  uint8_t       fill;           // Buffer of the conversion in progress
+  uint32_t      openCount;
+  uint32_t      closeCount;
+  uint32_t      convertCount;
+  uint32_t      cancelCount;
+  ADCBuf_Params params;         // Parameters of the last open
+  ADCBuf_Conversion *pConversion;
+} fakeAdcBuf_t;
+
+extern fakeAdcBuf_t fakeAdcBuf;
+
+// Simulated clock, read by Clock_getTicks
+extern uint32_t fakeClockTicks;
+
+extern void FakeAdcBuf_reset(void);
+
+// Completes the conversion in progress with every sample set to code.
+// Returns the completed buffer, NULL if no conversion was running.
+extern void *FakeAdcBuf_complete(uint16_t code);
+
+#endif /* FAKE_ADCBUF_H */
@@ -0,0 +1,31 @@
+/*
+ * RAM backed SNV for the host tests.
+ */
+#include <string.h>
+
+#include "osal_snv.h"
+
+#define FAKE_SNV_ITEM_SIZE  255
+
+static uint8 fakeSnvData[256][FAKE_SNV_ITEM_SIZE];
+static uint8 fakeSnvLen[256];
+
+uint8 osal_snv_read(osalSnvId_t id, osalSnvLen_t len, void *pBuf)
+{
+  if (fakeSnvLen[id] == 0 || len > fakeSnvLen[id])
+  {
+    return (FAILURE);
+  }
+
+  memcpy(pBuf, fakeSnvData[id], len);
+
+  return (SUCCESS);
+}
+
+uint8 osal_snv_write(osalSnvId_t id, osalSnvLen_t len, void *pBuf)
+{
+  memcpy(fakeSnvData[id], pBuf, len);
+  fakeSnvLen[id] = len;
+
+  return (SUCCESS);
+}
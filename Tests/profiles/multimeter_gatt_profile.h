@@ -0,0 +1,5 @@
+/*
+ * The application includes the profile as ../profiles/, found from the
+ * stub include directory on the host.
+ */
+#include "../../PROFILES/multimeter_gatt_profile.h"
@@ -0,0 +1,25 @@
+/*
+ * Host stand-in for the BLE stack's bcomdef.h, only the types and
+ * constants the multimeter modules use.
+ */
+#ifndef BCOMDEF_H
+#define BCOMDEF_H
+
+#include <stdint.h>
+
+typedef uint8_t  uint8;
+typedef uint16_t uint16;
+typedef uint32_t uint32;
+typedef int8_t   int8;
+typedef int16_t  int16;
+typedef int32_t  int32;
+typedef uint8_t  bStatus_t;
+
+#define SUCCESS                 0x00
+#define FAILURE                 0x01
+#define INVALIDPARAMETER        0x02
+
+#define BLE_NVID_CUST_START     0x80
+#define BLE_NVID_CUST_END       0x8F
+
+#endif /* BCOMDEF_H */
@@ -0,0 +1,13 @@
+/*
+ * Host stand-in for board.h, the ADCBuf instance and channel indices.
+ */
+#ifndef BOARD_H
+#define BOARD_H
+
+#define Board_ADCBUF0                           0
+#define Board_ADCBUFCHANNEL0                    0
+#define CC1350_LAUNCHXL_ADCBUF0CHANNELVSS       5
+#define CC1350_LAUNCHXL_ADCBUF0CHANNELDCOUPL    6
+#define CC1350_LAUNCHXL_ADCBUF0CHANNELVDDS      7
+
+#endif /* BOARD_H */
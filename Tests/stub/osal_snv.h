@@ -0,0 +1,16 @@
+/*
+ * Host stand-in for the OSAL simple non-volatile storage interface,
+ * implemented in RAM by fake_snv.c.
+ */
+#ifndef OSAL_SNV_H
+#define OSAL_SNV_H
+
+#include "bcomdef.h"
+
+typedef uint8 osalSnvId_t;
+typedef uint8 osalSnvLen_t;
+
+extern uint8 osal_snv_read(osalSnvId_t id, osalSnvLen_t len, void *pBuf);
+extern uint8 osal_snv_write(osalSnvId_t id, osalSnvLen_t len, void *pBuf);
+
+#endif /* OSAL_SNV_H */
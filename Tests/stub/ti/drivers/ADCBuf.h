@@ -0,0 +1,66 @@
+/*
+ * Host stand-in for the TI ADCBuf driver interface, implemented by
+ * fake_adcbuf.c.
+ */
+#ifndef ADCBUF_H
+#define ADCBUF_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define ADCBuf_STATUS_SUCCESS    (0)
+#define ADCBuf_STATUS_ERROR      (-1)
+
+typedef struct ADCBuf_Config_ *ADCBuf_Handle;
+
+typedef struct ADCBuf_Conversion_
+{
+  uint16_t samplesRequestedCount;
+  void     *sampleBuffer;
+  void     *sampleBufferTwo;
+  void     *arg;
+  uint32_t adcChannel;
+} ADCBuf_Conversion;
+
+typedef void (*ADCBuf_Callback)(ADCBuf_Handle handle,
+                                ADCBuf_Conversion *conversion,
+                                void *completedADCBuffer,
+                                uint32_t completedChannel);
+
+typedef enum ADCBuf_Recurrence_Mode_
+{
+  ADCBuf_RECURRENCE_MODE_ONE_SHOT,
+  ADCBuf_RECURRENCE_MODE_CONTINUOUS
+} ADCBuf_Recurrence_Mode;
+
+typedef enum ADCBuf_Return_Mode_
+{
+  ADCBuf_RETURN_MODE_BLOCKING,
+  ADCBuf_RETURN_MODE_CALLBACK
+} ADCBuf_Return_Mode;
+
+typedef struct ADCBuf_Params_
+{
+  uint32_t               blockingTimeout;
+  uint32_t               samplingFrequency;
+  ADCBuf_Return_Mode     returnMode;
+  ADCBuf_Callback        callbackFxn;
+  ADCBuf_Recurrence_Mode recurrenceMode;
+  void                   *custom;
+} ADCBuf_Params;
+
+extern void ADCBuf_init(void);
+extern void ADCBuf_Params_init(ADCBuf_Params *params);
+extern ADCBuf_Handle ADCBuf_open(uint_least8_t index, ADCBuf_Params *params);
+extern void ADCBuf_close(ADCBuf_Handle handle);
+extern int_fast16_t ADCBuf_convert(ADCBuf_Handle handle, ADCBuf_Conversion conversions[],
+                                   uint_fast8_t channelCount);
+extern int_fast16_t ADCBuf_convertCancel(ADCBuf_Handle handle);
+extern int_fast16_t ADCBuf_adjustRawValues(ADCBuf_Handle handle, void *sampleBuffer,
+                                           uint_fast16_t sampleCount, uint32_t adcChannel);
+extern int_fast16_t ADCBuf_convertAdjustedToMicroVolts(ADCBuf_Handle handle, uint32_t adcChannel,
+                                                       void *adjustedSampleBuffer,
+                                                       uint32_t outputMicroVoltBuffer[],
+                                                       uint_fast16_t sampleCount);
+
+#endif /* ADCBUF_H */
@@ -0,0 +1,14 @@
+/*
+ * Host stand-in for the SYS/BIOS Clock module, the tick count is set by
+ * the tests.
+ */
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <stdint.h>
+
+extern uint32_t Clock_tickPeriod;
+
+extern uint32_t Clock_getTicks(void);
+
+#endif /* CLOCK_H */
@@ -0,0 +1,32 @@
+/*
+ * Minimal check macros shared by the host tests.
+ */
+#ifndef TEST_H
+#define TEST_H
+
+#include <stdio.h>
+
+static int testFailures = 0;
+
+#define CHECK(cond) \
+  do { \
+    if (!(cond)) { \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+      testFailures++; \
+    } \
+  } while (0)
+
+#define CHECK_EQ(a, b) \
+  do { \
+    long long a_ = (long long)(a); \
+    long long b_ = (long long)(b); \
+    if (a_ != b_) { \
+      printf("%s:%d: %s == %lld, expected %lld\n", __FILE__, __LINE__, #a, a_, b_); \
+      testFailures++; \
+    } \
+  } while (0)
+
+#define TEST_DONE() \
+  (printf("%s: %s\n", __FILE__, testFailures ? "FAILED" : "passed"), testFailures != 0)
+
+#endif /* TEST_H */
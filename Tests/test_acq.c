@@ -0,0 +1,382 @@
+/*
+ * Ping-pong hand-off of the acquisition engine, driven by the simulated
+ * ADCBuf driver: windows alternate between the two buffers, a window
+ * whose buffer is refilled before it is taken or released is counted as
+ * an overrun, and a full descriptor ring as an overflow.
+ */
+#include "test.h"
+#include "fake_adcbuf.h"
+
+#include "multimeter_acq.h"
+
+static int windowCallbacks = 0;
+
+static void windowCB(void)
+{
+  windowCallbacks++;
+}
+
+static void testAlternation(void)
+{
+  multimeterAcqWindow_t window;
+  void *pFirst;
+  void *pSecond;
+  int i;
+
+  CHECK(MultimeterAcq_configure(1000, 100, 0, false, MultimeterAcqMains_Off));
+  CHECK(MultimeterAcq_start());
+  CHECK(fakeAdcBuf.running);
+  CHECK_EQ(fakeAdcBuf.params.recurrenceMode, ADCBuf_RECURRENCE_MODE_CONTINUOUS);
+  CHECK(!MultimeterAcq_getWindow(&window));
+
+  pFirst = NULL;
+  pSecond = NULL;
+  for (i = 0; i < 6; i++)
+  {
+    void *pBuffer = FakeAdcBuf_complete((uint16_t)(100 + i));
+
+    CHECK_EQ(windowCallbacks, i + 1);
+    CHECK(MultimeterAcq_getWindow(&window));
+    CHECK(window.samples == pBuffer);
+    CHECK_EQ(window.count, 100);
+    CHECK_EQ(window.buffer, i & 1);
+    CHECK_EQ(window.samples[0], 100 + i);
+    CHECK_EQ(window.samples[99], 100 + i);
+    CHECK(MultimeterAcq_releaseWindow(&window));
+    CHECK(!MultimeterAcq_getWindow(&window));
+
+    if (i == 0)
+    {
+      pFirst = pBuffer;
+    }
+    else if (i == 1)
+    {
+      pSecond = pBuffer;
+    }
+    else
+    {
+      CHECK(pBuffer == ((i & 1) ? pSecond : pFirst));
+    }
+  }
+  CHECK(pFirst != pSecond);
+  CHECK_EQ(MultimeterAcq_getOverrunCount(), 0);
+  CHECK_EQ(MultimeterAcq_getOverflowCount(), 0);
+}
+
+static void testOverrun(void)
+{
+  multimeterAcqWindow_t window;
+  multimeterAcqWindow_t held;
+  uint32_t overruns = MultimeterAcq_getOverrunCount();
+
+  // The task holds a window while the driver completes the next one and
+  // starts refilling the held buffer: the result must be discarded
+  CHECK(MultimeterAcq_start());
+  FakeAdcBuf_complete(1);
+  CHECK(MultimeterAcq_getWindow(&held));
+  CHECK(MultimeterAcq_releaseWindow(&held));
+  FakeAdcBuf_complete(2);
+  CHECK(!MultimeterAcq_releaseWindow(&held));
+  CHECK_EQ(MultimeterAcq_getOverrunCount(), overruns + 1);
+
+  // The second window is still intact
+  CHECK(MultimeterAcq_getWindow(&window));
+  CHECK_EQ(window.samples[0], 2);
+  CHECK(MultimeterAcq_releaseWindow(&window));
+
+  // Three windows queued while the task was busy: the first two buffers
+  // have been refilled since, only the latest window is handed out
+  FakeAdcBuf_complete(3);
+  FakeAdcBuf_complete(4);
+  FakeAdcBuf_complete(5);
+  CHECK(MultimeterAcq_getWindow(&window));
+  CHECK_EQ(window.samples[0], 5);
+  CHECK(MultimeterAcq_releaseWindow(&window));
+  CHECK(!MultimeterAcq_getWindow(&window));
+  CHECK_EQ(MultimeterAcq_getOverrunCount(), overruns + 3);
+}
+
+static void testOverflow(void)
+{
+  multimeterAcqWindow_t window;
+  uint32_t overflows = MultimeterAcq_getOverflowCount();
+  int i;
+
+  CHECK(MultimeterAcq_start());
+  for (i = 0; i < MULTIMETER_ACQ_RING_SIZE + 2; i++)
+  {
+    FakeAdcBuf_complete((uint16_t)i);
+  }
+  CHECK_EQ(MultimeterAcq_getOverflowCount(), overflows + 2);
+
+  // Restarting drops whatever is still queued
+  CHECK(MultimeterAcq_start());
+  CHECK(!MultimeterAcq_getWindow(&window));
+}
+
+static void testStandby(void)
+{
+  multimeterAcqWindow_t window;
+
+  // A completion reported after the cancel is ignored
+  CHECK(MultimeterAcq_start());
+  MultimeterAcq_standby();
+  CHECK(!fakeAdcBuf.running);
+  CHECK(fakeAdcBuf.open);
+  fakeAdcBuf.running = true;
+  FakeAdcBuf_complete(7);
+  CHECK(!MultimeterAcq_getWindow(&window));
+  fakeAdcBuf.running = false;
+}
+
+static void testConfigure(void)
+{
+  multimeterAcqWindow_t window;
+  uint32_t opens;
+
+  CHECK(MultimeterAcq_configure(1000, 100, 0, false, MultimeterAcqMains_Off));
+  CHECK(MultimeterAcq_start());
+  opens = fakeAdcBuf.openCount;
+
+  // Window and oversampling are not open parameters, the ADC stays open
+  // and the running acquisition is rearmed with the new window
+  CHECK(MultimeterAcq_configure(1000, 64, 1, false, MultimeterAcqMains_Off));
+  CHECK_EQ(fakeAdcBuf.openCount, opens);
+  CHECK(fakeAdcBuf.open);
+  CHECK(fakeAdcBuf.running);
+  FakeAdcBuf_complete(9);
+  CHECK(MultimeterAcq_getWindow(&window));
+  CHECK_EQ(window.count, 64);
+
+  // A new sampling frequency reopens the driver
+  CHECK(MultimeterAcq_configure(2000, 64, 1, false, MultimeterAcqMains_Off));
+  CHECK_EQ(fakeAdcBuf.openCount, opens + 1);
+  CHECK_EQ(fakeAdcBuf.params.samplingFrequency, 2000);
+  CHECK(fakeAdcBuf.running);
+
+  // So does the reference scan, it needs one-shot conversions
+  CHECK(MultimeterAcq_configure(2000, 64, 1, true, MultimeterAcqMains_Off));
+  CHECK_EQ(fakeAdcBuf.openCount, opens + 2);
+  CHECK_EQ(fakeAdcBuf.params.recurrenceMode, ADCBuf_RECURRENCE_MODE_ONE_SHOT);
+
+  // A stopped acquisition stays stopped, the ADC warm
+  MultimeterAcq_standby();
+  CHECK(MultimeterAcq_configure(2000, 100, 0, true, MultimeterAcqMains_Off));
+  CHECK_EQ(fakeAdcBuf.openCount, opens + 2);
+  CHECK(fakeAdcBuf.open);
+  CHECK(!fakeAdcBuf.running);
+
+  CHECK(MultimeterAcq_configure(1000, 100, 0, false, MultimeterAcqMains_Off));
+}
+
+// Runs one scan of the reference channels and the measurement and takes
+// the window
+static bool scanWindow(multimeterAcqWindow_t *pWindow)
+{
+  int slot;
+
+  for (slot = 0; slot < MultimeterAcqRef_Count; slot++)
+  {
+    FakeAdcBuf_complete((uint16_t)(10 * (slot + 1)));
+  }
+  FakeAdcBuf_complete(500);
+
+  return (MultimeterAcq_getWindow(pWindow) && MultimeterAcq_releaseWindow(pWindow));
+}
+
+static void testRequireRefScan(void)
+{
+  multimeterAcqWindow_t window;
+  int i;
+
+  CHECK(MultimeterAcq_configure(1000, 100, 0, false, MultimeterAcqMains_Off));
+  CHECK(MultimeterAcq_start());
+
+  // A required scan runs without changing the configured setting
+  CHECK(MultimeterAcq_requireRefScan(true));
+  CHECK(!MultimeterAcq_getRefScan());
+  CHECK_EQ(fakeAdcBuf.params.recurrenceMode, ADCBuf_RECURRENCE_MODE_ONE_SHOT);
+  CHECK(fakeAdcBuf.running);
+  CHECK(scanWindow(&window));
+  CHECK(window.refValid);
+  for (i = 0; i < MultimeterAcqRef_Count; i++)
+  {
+    CHECK_EQ(window.refCode[i], 10 * (i + 1));
+  }
+  CHECK_EQ(window.samples[0], 500);
+
+  // and survives a reconfiguration
+  CHECK(MultimeterAcq_configure(1000, 64, 0, false, MultimeterAcqMains_Off));
+  CHECK_EQ(fakeAdcBuf.params.recurrenceMode, ADCBuf_RECURRENCE_MODE_ONE_SHOT);
+  CHECK(scanWindow(&window));
+  CHECK(window.refValid);
+  CHECK_EQ(window.count, 64);
+
+  // The configured setting applies again once no longer required
+  CHECK(MultimeterAcq_requireRefScan(false));
+  CHECK_EQ(fakeAdcBuf.params.recurrenceMode, ADCBuf_RECURRENCE_MODE_CONTINUOUS);
+  FakeAdcBuf_complete(7);
+  CHECK(MultimeterAcq_getWindow(&window));
+  CHECK(!window.refValid);
+
+  MultimeterAcq_standby();
+  fakeAdcBuf.running = false;
+  CHECK(MultimeterAcq_configure(1000, 100, 0, false, MultimeterAcqMains_Off));
+}
+
+static void testConfigSaveRestore(void)
+{
+  multimeterAcqConfig_t config;
+  multimeterAcqConfig_t saved;
+  uint16_t samples[MULTIMETER_ACQ_MAINS_DETECT_WINDOW];
+  int i;
+
+  // The requested settings come back, not the mains adjusted ones
+  CHECK(MultimeterAcq_configure(1030, 100, 1, false, MultimeterAcqMains_50Hz));
+  CHECK_EQ(MultimeterAcq_getSamplingFrequency(), 1000);
+  MultimeterAcq_getConfig(&config);
+  CHECK_EQ(config.samplingFrequency, 1030);
+  CHECK_EQ(config.windowSize, 100);
+  CHECK_EQ(config.oversamplingBits, 1);
+  CHECK(!config.refScan);
+  CHECK_EQ(config.mains, MultimeterAcqMains_50Hz);
+
+  // A detected mains frequency survives restoring the Auto setting
+  CHECK(MultimeterAcq_configure(1030, 100, 0, false, MultimeterAcqMains_Auto));
+  CHECK(MultimeterAcq_isDetectingMains());
+  for (i = 0; i < MULTIMETER_ACQ_MAINS_DETECT_WINDOW; i++)
+  {
+    // 60 Hz at 600 Hz sampling, ten samples per cycle
+    samples[i] = (uint16_t)(2048 + ((i % 10) < 5 ? 500 : -500));
+  }
+  CHECK(MultimeterAcq_detectMains(samples, MULTIMETER_ACQ_MAINS_DETECT_WINDOW));
+  CHECK_EQ(MultimeterAcq_getMainsFrequency(), 60);
+
+  MultimeterAcq_getConfig(&saved);
+  CHECK(MultimeterAcq_configure(saved.samplingFrequency, 10, saved.oversamplingBits,
+                                saved.refScan, saved.mains));
+  CHECK(MultimeterAcq_configure(saved.samplingFrequency, saved.windowSize, saved.oversamplingBits,
+                                saved.refScan, saved.mains));
+  CHECK(!MultimeterAcq_isDetectingMains());
+  CHECK_EQ(MultimeterAcq_getMainsFrequency(), 60);
+  MultimeterAcq_getConfig(&config);
+  CHECK_EQ(config.samplingFrequency, 1030);
+  CHECK_EQ(config.mains, MultimeterAcqMains_Auto);
+
+  // Turning synchronisation off and on again detects anew
+  CHECK(MultimeterAcq_configure(1030, 100, 0, false, MultimeterAcqMains_Off));
+  CHECK(MultimeterAcq_configure(1030, 100, 0, false, MultimeterAcqMains_Auto));
+  CHECK(MultimeterAcq_isDetectingMains());
+
+  MultimeterAcq_standby();
+  fakeAdcBuf.running = false;
+  CHECK(MultimeterAcq_configure(1000, 100, 0, false, MultimeterAcqMains_Off));
+}
+
+static void testSettleCut(void)
+{
+  multimeterAcqWindow_t window;
+  multimeterAcqSettle_t settle;
+  uint32_t discarded;
+
+  // 4^4 oversampling at 200 kHz, the 2 ms settle of DIO21 + DIO22 is 400
+  // samples. Cut in whole groups it takes 512, leaving less than one
+  // output of the window, which is dropped.
+  CHECK(MultimeterAcq_configure(200000, 512, 4, false, MultimeterAcqMains_Off));
+  MultimeterAcq_getSettle(&settle);
+  discarded = settle.discardedSamples;
+  CHECK(MultimeterAcq_switchRange(1, 1));
+  FakeAdcBuf_complete(1);
+  CHECK(!MultimeterAcq_getWindow(&window));
+  FakeAdcBuf_complete(2);
+  CHECK(MultimeterAcq_getWindow(&window));
+  CHECK_EQ(window.count, 512);
+  CHECK_EQ(window.discarded, 0);
+  CHECK_EQ(window.samples[0], 2);
+  MultimeterAcq_getSettle(&settle);
+  CHECK_EQ(settle.discardedSamples, discarded + 512);
+
+  // The 200 us settle of neither line is 40 samples, rounded up to a group
+  CHECK(MultimeterAcq_switchRange(0, 0));
+  FakeAdcBuf_complete(3);
+  CHECK(MultimeterAcq_getWindow(&window));
+  CHECK_EQ(window.discarded, 256);
+  CHECK_EQ(window.count, 256);
+
+  // A settle longer than a window carries over, and the remainder is cut
+  // from the next window in whole groups again
+  CHECK(MultimeterAcq_configure(200000, 256, 4, false, MultimeterAcqMains_Off));
+  CHECK(MultimeterAcq_switchRange(1, 1));
+  FakeAdcBuf_complete(4);
+  CHECK(!MultimeterAcq_getWindow(&window));
+  FakeAdcBuf_complete(5);
+  CHECK(!MultimeterAcq_getWindow(&window));
+  FakeAdcBuf_complete(6);
+  CHECK(MultimeterAcq_getWindow(&window));
+  CHECK_EQ(window.count, 256);
+  CHECK_EQ(window.discarded, 0);
+
+  MultimeterAcq_standby();
+  fakeAdcBuf.running = false;
+  CHECK(MultimeterAcq_configure(1000, 100, 0, false, MultimeterAcqMains_Off));
+}
+
+static void testSwitchAfterOff(void)
+{
+  multimeterAcqWindow_t window;
+  multimeterAcqSettle_t settle;
+  uint32_t switches;
+
+  // At 1 kHz the 1 ms settle of DIO22 alone is one sample
+  CHECK(MultimeterAcq_switchRange(0, 1));
+  FakeAdcBuf_complete(1);
+  CHECK(MultimeterAcq_getWindow(&window));
+  CHECK_EQ(window.discarded, 1);
+  CHECK(MultimeterAcq_releaseWindow(&window));
+
+  // The same levels again settle nothing
+  CHECK(MultimeterAcq_switchRange(0, 1));
+  FakeAdcBuf_complete(2);
+  CHECK(MultimeterAcq_getWindow(&window));
+  CHECK_EQ(window.discarded, 0);
+  CHECK(MultimeterAcq_releaseWindow(&window));
+
+  // Off drives both lines low in standby, so coming back to the same
+  // range is a switch again
+  MultimeterAcq_getSettle(&settle);
+  switches = settle.switchCount;
+  MultimeterAcq_standby();
+  fakeAdcBuf.running = false;
+  MultimeterAcq_setSwitchLevels(0, 0);
+  CHECK(MultimeterAcq_switchRange(0, 1));
+  FakeAdcBuf_complete(3);
+  CHECK(MultimeterAcq_getWindow(&window));
+  CHECK_EQ(window.discarded, 1);
+  CHECK(MultimeterAcq_releaseWindow(&window));
+  MultimeterAcq_getSettle(&settle);
+  CHECK_EQ(settle.switchCount, switches + 1);
+
+  MultimeterAcq_standby();
+  fakeAdcBuf.running = false;
+  CHECK(MultimeterAcq_configure(1000, 100, 0, false, MultimeterAcqMains_Off));
+}
+
+int main(void)
+{
+  FakeAdcBuf_reset();
+  MultimeterAcq_init(windowCB);
+  CHECK(fakeAdcBuf.open);
+  CHECK(!fakeAdcBuf.running);
+
+  testAlternation();
+  testOverrun();
+  testOverflow();
+  testStandby();
+  testConfigure();
+  testRequireRefScan();
+  testConfigSaveRestore();
+  testSettleCut();
+  testSwitchAfterOff();
+
+  return (TEST_DONE());
+}
@@ -0,0 +1,57 @@
+/*
+ * The charge and energy totals integrated over stretches of time of any
+ * length, down to the 10 us clock tick.
+ */
+#include "test.h"
+
+#include "multimeter_charge.h"
+
+int main(void)
+{
+  multimeterChargeSummary_t summary;
+  uint32_t i;
+
+  // 100 mA at 5 V for an hour in 100 ms windows
+  MultimeterCharge_reset();
+  MultimeterCharge_setVoltage(5000000);
+  for (i = 0; i < 36000; i++)
+  {
+    MultimeterCharge_add(100000, 100000);
+  }
+  MultimeterCharge_get(&summary);
+  CHECK_EQ(summary.microAmpHours, 100000);
+  CHECK_EQ(summary.microWattHours, 500000);
+  CHECK_EQ(summary.microVolt, 5000000);
+  CHECK_EQ(summary.seconds, 3600);
+
+  // the same hour in uneven stretches, including single clock ticks
+  MultimeterCharge_reset();
+  for (i = 0; i < 3600; i++)
+  {
+    MultimeterCharge_add(100000, 10);
+    MultimeterCharge_add(100000, 999990);
+  }
+  MultimeterCharge_get(&summary);
+  CHECK_EQ(summary.microAmpHours, 100000);
+  CHECK_EQ(summary.microWattHours, 500000);
+  CHECK_EQ(summary.seconds, 3600);
+
+  // a long gap in one go, and a current flowing back
+  MultimeterCharge_reset();
+  MultimeterCharge_add(500000, 3600000000UL);
+  MultimeterCharge_add(-250000, 3600000000UL);
+  MultimeterCharge_get(&summary);
+  CHECK_EQ(summary.microAmpHours, 250000);
+  CHECK_EQ(summary.microWattHours, 1250000);
+  CHECK_EQ(summary.seconds, 7200);
+
+  // without a voltage there is no energy
+  MultimeterCharge_reset();
+  MultimeterCharge_setVoltage(0);
+  MultimeterCharge_add(100000, 36000000);
+  MultimeterCharge_get(&summary);
+  CHECK_EQ(summary.microAmpHours, 1000);
+  CHECK_EQ(summary.microWattHours, 0);
+
+  return TEST_DONE();
+}
@@ -0,0 +1,168 @@
+/*
+ * Frequency counting on the raw ADC stream, fed in windows like the
+ * acquisition delivers them. Signals slower than the window rate have to
+ * be counted once per cycle, not once per window.
+ */
+#include <math.h>
+#include <stdlib.h>
+
+#include "test.h"
+
+#include "multimeter_freq.h"
+
+#define FS            1000
+#define WINDOW        100
+#define PI            3.14159265358979
+
+typedef enum
+{
+  Shape_Sine,
+  Shape_Square
+} Shape;
+
+// Feeds the signal for the given time and returns the measured frequency
+// over every result with complete cycles, 0 if there was none
+static double measure(Shape shape, double frequency, double seconds,
+                      double amplitude, unsigned int seed)
+{
+  uint16_t samples[WINDOW];
+  multimeterFreqResult_t result;
+  uint64_t cycles = 0;
+  uint64_t span = 0;
+  uint32_t timebase = 0;
+  long n = 0;
+  long total = (long)(seconds * FS);
+  int i;
+  double phase;
+  double value;
+
+  MultimeterFreq_reset();
+  srand(seed);
+
+  while (n < total)
+  {
+    for (i = 0; i < WINDOW; i++, n++)
+    {
+      phase = 2 * PI * frequency * n / FS;
+      value = (shape == Shape_Sine) ? sin(phase) : (sin(phase) >= 0 ? 1 : -1);
+      // a few codes of noise
+      samples[i] = (uint16_t)(2048 + amplitude * value + (rand() % 9) - 4);
+    }
+
+    MultimeterFreq_process(samples, WINDOW, FS);
+    if (MultimeterFreq_get(&result, FS) && result.cycles > 0)
+    {
+      cycles += result.cycles;
+      span += result.span;
+      timebase = result.timebase;
+    }
+  }
+
+  return span ? (double)cycles * timebase / span : 0;
+}
+
+static void checkFrequency(Shape shape, double frequency, double amplitude)
+{
+  double measured = measure(shape, frequency, 20, amplitude, 1);
+
+  printf("%s %5.1f Hz, amplitude %4.0f: %.3f Hz\n",
+         shape == Shape_Sine ? "sine  " : "square", frequency, amplitude, measured);
+  CHECK(fabs(measured - frequency) <= frequency * 0.01);
+}
+
+// A window whose samples were overwritten is rolled back and leaves the
+// measurement exactly as if it had never been seen
+static void testRollback(void)
+{
+  uint16_t samples[WINDOW];
+  uint16_t torn[WINDOW];
+  multimeterFreqResult_t result;
+  uint32_t cycles[2] = { 0, 0 };
+  uint32_t span[2] = { 0, 0 };
+  long n;
+  int pass;
+  int i;
+
+  for (i = 0; i < WINDOW; i++)
+  {
+    torn[i] = (i & 4) ? 4000 : 100;
+  }
+
+  for (pass = 0; pass < 2; pass++)
+  {
+    MultimeterFreq_reset();
+    for (n = 0; n < 3 * FS; )
+    {
+      for (i = 0; i < WINDOW; i++, n++)
+      {
+        samples[i] = (uint16_t)(2048 + 1800 * sin(2 * PI * 3 * n / FS));
+      }
+
+      if (pass == 1)
+      {
+        MultimeterFreq_process(torn, WINDOW, FS);
+        MultimeterFreq_rollback();
+      }
+
+      MultimeterFreq_process(samples, WINDOW, FS);
+      if (MultimeterFreq_get(&result, FS))
+      {
+        cycles[pass] += result.cycles;
+        span[pass] += result.span;
+      }
+    }
+  }
+
+  CHECK(cycles[0] > 0);
+  CHECK_EQ(cycles[1], cycles[0]);
+  CHECK_EQ(span[1], span[0]);
+}
+
+int main(void)
+{
+  multimeterFreqResult_t result;
+  uint16_t samples[WINDOW];
+  int i;
+
+  // below, at and above the window rate of 10 Hz
+  checkFrequency(Shape_Sine, 0.5, 1800);
+  checkFrequency(Shape_Sine, 1, 1800);
+  checkFrequency(Shape_Sine, 5, 1800);
+  checkFrequency(Shape_Sine, 10, 1800);
+  checkFrequency(Shape_Sine, 50, 1800);
+  checkFrequency(Shape_Sine, 0.5, 200);
+  checkFrequency(Shape_Sine, 5, 200);
+  checkFrequency(Shape_Square, 0.5, 1800);
+  checkFrequency(Shape_Square, 1, 1800);
+  checkFrequency(Shape_Square, 7, 1800);
+
+  testRollback();
+
+  // a slow square wave is still a clean logic level signal
+  measure(Shape_Square, 1, 3, 1800, 2);
+  MultimeterFreq_process(samples, 0, FS);
+  for (i = 0; i < WINDOW; i++)
+  {
+    samples[i] = (i < WINDOW / 2) ? 248 : 3848;
+  }
+  MultimeterFreq_process(samples, WINDOW, FS);
+  CHECK(MultimeterFreq_get(&result, FS));
+  CHECK(result.clean);
+
+  // a level without a signal times out to 0 Hz and never counts
+  MultimeterFreq_reset();
+  for (i = 0; i < WINDOW; i++)
+  {
+    samples[i] = 2048 + (i % 5);
+  }
+  for (i = 0; i < 3 * MULTIMETER_FREQ_TIMEOUT / WINDOW; i++)
+  {
+    MultimeterFreq_process(samples, WINDOW, FS);
+    if (MultimeterFreq_get(&result, FS))
+    {
+      CHECK_EQ(result.cycles, 0);
+    }
+  }
+
+  return TEST_DONE();
+}
@@ -0,0 +1,236 @@
+/*
+ * The window reducers against plain sort based references: the median,
+ * the trimmed mean, the Hampel-filtered mean and the exponential average
+ * across windows. Empty windows and windows of equal codes are included.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "test.h"
+
+#include "multimeter_reduce.h"
+
+#define MAX_COUNT     1024
+
+static uint16_t window[MAX_COUNT];
+static uint16_t sorted[MAX_COUNT];
+
+static int compareCodes(const void *a, const void *b)
+{
+  return (int)*(const uint16_t *)a - (int)*(const uint16_t *)b;
+}
+
+static void sortWindow(uint16_t count)
+{
+  memcpy(sorted, window, count * sizeof(uint16_t));
+  qsort(sorted, count, sizeof(uint16_t), compareCodes);
+}
+
+// Mean of the sorted codes from first to last with the reducers'
+// fractional bits, rounded like them
+static uint32_t sortedMean(uint16_t first, uint16_t last)
+{
+  uint64_t sum = 0;
+  uint16_t kept = last - first + 1;
+  uint16_t i;
+
+  for (i = first; i <= last; i++)
+  {
+    sum += sorted[i];
+  }
+
+  return (uint32_t)(((sum << MULTIMETER_REDUCE_MEAN_FRAC_BITS) + kept / 2) / kept);
+}
+
+static uint32_t referenceHampel(uint16_t count, uint16_t median, uint8_t thresholdTenths)
+{
+  static uint16_t distances[MAX_COUNT];
+  uint64_t sum = 0;
+  uint16_t kept = 0;
+  uint32_t limit;
+  uint16_t i;
+
+  for (i = 0; i < count; i++)
+  {
+    distances[i] = abs((int)window[i] - (int)median);
+  }
+  qsort(distances, count, sizeof(uint16_t), compareCodes);
+  limit = (uint32_t)(((uint64_t)distances[count / 2] * thresholdTenths * 14826 + 50000) / 100000);
+  if (limit < 1)
+  {
+    limit = 1;
+  }
+
+  for (i = 0; i < count; i++)
+  {
+    if ((uint32_t)abs((int)window[i] - (int)median) <= limit)
+    {
+      sum += window[i];
+      kept++;
+    }
+  }
+
+  return (uint32_t)(((sum << MULTIMETER_REDUCE_MEAN_FRAC_BITS) + kept / 2) / kept);
+}
+
+static void checkWindow(uint16_t count, uint8_t bits)
+{
+  multimeterReduceStats_t stats;
+  uint16_t trim;
+  uint8_t percent;
+  uint8_t tenths;
+
+  sortWindow(count);
+  MultimeterReduce_window(window, count, bits, &stats);
+
+  CHECK_EQ(stats.count, count);
+  CHECK_EQ(stats.median, sorted[count / 2]);
+  CHECK_EQ(stats.min, sorted[0]);
+  CHECK_EQ(stats.max, sorted[count - 1]);
+  if (bits == MULTIMETER_REDUCE_CODE_BITS)
+  {
+    CHECK_EQ(MultimeterReduce_median(window, count), sorted[count / 2]);
+  }
+
+  for (percent = 0; percent <= MULTIMETER_REDUCE_MAX_TRIM; percent += 7)
+  {
+    trim = (uint16_t)(((uint32_t)count * percent) / 100);
+    CHECK_EQ(MultimeterReduce_trimmedMean(window, count, bits, percent),
+             sortedMean(trim, count - 1 - trim));
+  }
+
+  for (tenths = MULTIMETER_REDUCE_MIN_HAMPEL; tenths <= 60; tenths += 11)
+  {
+    CHECK_EQ(MultimeterReduce_hampelMean(window, count, bits, stats.median, tenths),
+             referenceHampel(count, stats.median, tenths));
+  }
+}
+
+static void checkRandomWindows(uint8_t bits)
+{
+  uint16_t mask = (1 << bits) - 1;
+  uint16_t count;
+  uint16_t i;
+  int run;
+
+  for (run = 0; run < 200; run++)
+  {
+    count = 1 + rand() % MAX_COUNT;
+    for (i = 0; i < count; i++)
+    {
+      // noise around a level with a few outliers
+      window[i] = (rand() % 16 == 0) ? rand() & mask : ((mask / 3) + rand() % 64) & mask;
+    }
+    checkWindow(count, bits);
+  }
+}
+
+static void checkEqualWindows(void)
+{
+  multimeterReduceStats_t stats;
+  uint16_t counts[] = { 1, 2, 3, 100, MAX_COUNT };
+  uint16_t codes[] = { 0, 1, 2047, 4095 };
+  unsigned int c;
+  unsigned int k;
+  uint16_t i;
+
+  for (c = 0; c < sizeof(counts) / sizeof(counts[0]); c++)
+  {
+    for (k = 0; k < sizeof(codes) / sizeof(codes[0]); k++)
+    {
+      for (i = 0; i < counts[c]; i++)
+      {
+        window[i] = codes[k];
+      }
+      checkWindow(counts[c], MULTIMETER_REDUCE_CODE_BITS);
+
+      MultimeterReduce_window(window, counts[c], MULTIMETER_REDUCE_CODE_BITS, &stats);
+      CHECK_EQ(stats.variance, 0);
+      CHECK_EQ(MultimeterReduce_trimmedMean(window, counts[c], MULTIMETER_REDUCE_CODE_BITS, 25),
+               codes[k] << MULTIMETER_REDUCE_MEAN_FRAC_BITS);
+      CHECK_EQ(MultimeterReduce_hampelMean(window, counts[c], MULTIMETER_REDUCE_CODE_BITS,
+                                           codes[k], MULTIMETER_REDUCE_DEFAULT_HAMPEL),
+               codes[k] << MULTIMETER_REDUCE_MEAN_FRAC_BITS);
+    }
+  }
+}
+
+static void checkEmptyWindow(void)
+{
+  multimeterReduceStats_t stats;
+
+  memset(&stats, 0xA5, sizeof(stats));
+  MultimeterReduce_window(window, 0, MULTIMETER_REDUCE_CODE_BITS, &stats);
+  CHECK_EQ(stats.median, 0);
+  CHECK_EQ(stats.min, 0);
+  CHECK_EQ(stats.max, 0);
+  CHECK_EQ(stats.count, 0);
+  CHECK_EQ(stats.sum, 0);
+  CHECK_EQ(stats.variance, 0);
+
+  CHECK_EQ(MultimeterReduce_median(window, 0), 0);
+  CHECK_EQ(MultimeterReduce_trimmedMean(window, 0, MULTIMETER_REDUCE_CODE_BITS, 25), 0);
+  CHECK_EQ(MultimeterReduce_hampelMean(window, 0, MULTIMETER_REDUCE_CODE_BITS, 0, 30), 0);
+}
+
+static void checkIir(void)
+{
+  int32_t accumulator = 12345;
+  int32_t average;
+  uint8_t shift;
+  int i;
+
+  // the first input starts the average
+  CHECK_EQ(MultimeterReduce_iir(&accumulator, false, 678, 3), 678);
+
+  // a constant input holds it exactly
+  average = MultimeterReduce_iir(&accumulator, false, 4000, 3);
+  for (i = 0; i < 100; i++)
+  {
+    average = MultimeterReduce_iir(&accumulator, true, 4000, 3);
+  }
+  CHECK_EQ(average, 4000);
+
+  for (shift = 0; shift <= MULTIMETER_REDUCE_MAX_IIR_SHIFT; shift++)
+  {
+    // a step settles to within 1 unit of the input from either side,
+    // having covered 1 - 1/e of it after about 2^shift steps
+    average = MultimeterReduce_iir(&accumulator, false, 0, shift);
+    for (i = 0; i < (1 << shift); i++)
+    {
+      average = MultimeterReduce_iir(&accumulator, true, 65536, shift);
+    }
+    CHECK(average >= 65536 * 6 / 10);
+    for (i = 0; i < 40 << shift; i++)
+    {
+      average = MultimeterReduce_iir(&accumulator, true, 65536, shift);
+    }
+    CHECK(average <= 65536 && average >= 65536 - 1);
+
+    for (i = 0; i < 40 << shift; i++)
+    {
+      average = MultimeterReduce_iir(&accumulator, true, -65536, shift);
+    }
+    CHECK(average >= -65536 && average <= -65536 + 1);
+
+    // a small step is followed too, not stalled short of it
+    for (i = 0; i < 40 << shift; i++)
+    {
+      average = MultimeterReduce_iir(&accumulator, true, -65536 + 3, shift);
+    }
+    CHECK(average >= -65536 + 2 && average <= -65536 + 3);
+  }
+}
+
+int main(void)
+{
+  srand(1);
+
+  checkEmptyWindow();
+  checkEqualWindows();
+  checkRandomWindows(MULTIMETER_REDUCE_CODE_BITS);
+  checkRandomWindows(MULTIMETER_REDUCE_MAX_CODE_BITS);
+  checkIir();
+
+  return TEST_DONE();
+}
@@ -0,0 +1,148 @@
+/*
+ * Two-thread stress test of the window ring. The producer thread plays
+ * the driver: it fills the two buffers alternately, every sample with the
+ * window's sequence number, and puts each completed window. The consumer
+ * thread plays the task, at an irregular pace so that windows overflow
+ * the ring and buffers are refilled under it. Every window handed out
+ * must come in order with the generation of its buffer, every released
+ * window must hold only its own samples, and every window must be
+ * accounted for exactly once as used, overrun or overflow.
+ */
+#define _POSIX_C_SOURCE 200112L
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+
+#include "test.h"
+
+#include "multimeter_ring.h"
+
+#define RING_TEST_WINDOWS   1000000UL
+#define RING_TEST_SAMPLES   32
+
+static volatile uint16_t ringTestBuffers[MULTIMETER_RING_NUM_BUFFERS][RING_TEST_SAMPLES];
+static volatile int ringTestDone = 0;
+
+static void spin(unsigned int n)
+{
+  volatile unsigned int i;
+
+  for (i = 0; i < n; i++)
+  {
+  }
+}
+
+static void *producer(void *arg)
+{
+  multimeterAcqWindow_t window = { 0 };
+  unsigned int seed = 1;
+  uint32_t seq;
+  uint8_t buffer;
+  int i;
+
+  (void)arg;
+
+  for (seq = 0; seq < RING_TEST_WINDOWS; seq++)
+  {
+    // DMA into the buffer the previous put handed back
+    buffer = seq & 1;
+    for (i = 0; i < RING_TEST_SAMPLES; i++)
+    {
+      ringTestBuffers[buffer][i] = (uint16_t)seq;
+    }
+    __sync_synchronize();
+
+    window.samples = (uint16_t *)ringTestBuffers[buffer];
+    window.count = RING_TEST_SAMPLES;
+    window.buffer = buffer;
+    window.ticks = seq;
+    MultimeterRing_put(&window);
+
+    // Hand the core over now and then, the host may have only one
+    spin(rand_r(&seed) % 400);
+    if (rand_r(&seed) % 4 == 0)
+    {
+      sched_yield();
+    }
+  }
+
+  ringTestDone = 1;
+
+  return (NULL);
+}
+
+int main(void)
+{
+  multimeterAcqWindow_t window;
+  pthread_t thread;
+  unsigned int seed = 2;
+  uint32_t used = 0;
+  uint32_t lastSeq = 0;
+  bool first = true;
+  bool intact;
+  int i;
+
+  CHECK(pthread_create(&thread, NULL, producer, NULL) == 0);
+
+  for (;;)
+  {
+    int done = ringTestDone;
+
+    if (!MultimeterRing_get(&window))
+    {
+      if (done && !MultimeterRing_get(&window))
+      {
+        break;
+      }
+      sched_yield();
+      continue;
+    }
+
+    // Windows come out in the order they were put, with the generation
+    // their buffer had then: one refill per window of the other buffer
+    CHECK(first || window.ticks > lastSeq);
+    CHECK_EQ(window.generation, (window.ticks + 1) / 2);
+    CHECK_EQ(window.buffer, window.ticks & 1);
+    first = false;
+    lastSeq = window.ticks;
+
+    // Mostly keep up, now and then fall behind by a few windows
+    intact = true;
+    for (i = 0; i < window.count; i++)
+    {
+      intact = intact && (window.samples[i] == (uint16_t)window.ticks);
+      if ((i == window.count / 2) && (rand_r(&seed) % 16 == 0))
+      {
+        spin(rand_r(&seed) % 5000);
+        sched_yield();
+      }
+    }
+
+    if (MultimeterRing_release(&window))
+    {
+      // A window released intact was never refilled while it was read
+      CHECK(intact);
+      used++;
+    }
+  }
+
+  pthread_join(thread, NULL);
+
+  printf("%lu windows: %lu used, %lu overruns, %lu overflows\n", RING_TEST_WINDOWS,
+         (unsigned long)used, (unsigned long)MultimeterRing_getOverrunCount(),
+         (unsigned long)MultimeterRing_getOverflowCount());
+
+  CHECK_EQ(used + MultimeterRing_getOverrunCount() + MultimeterRing_getOverflowCount(),
+           RING_TEST_WINDOWS);
+  CHECK(used > 0);
+  CHECK(MultimeterRing_getOverrunCount() > 0);
+  CHECK(MultimeterRing_getOverflowCount() > 0);
+
+  // A window lost by the producer counts as an overrun
+  i = MultimeterRing_getOverrunCount();
+  MultimeterRing_countLost();
+  CHECK_EQ(MultimeterRing_getOverrunCount(), i + 1);
+
+  return (TEST_DONE());
+}
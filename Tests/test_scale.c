@@ -0,0 +1,56 @@
+/*
+ * The Q20 scaling tables against the double expressions they replaced,
+ * reading = microVolt / 0.3 on the 10V range and microVolt / 6.85 - 1200
+ * on the 500mA range, over the whole ADC input span. The fixed-point
+ * result must stay within one ADC LSB of the double result; it is in fact
+ * within a couple of output units.
+ */
+#include <math.h>
+
+#include "test.h"
+
+#include "multimeter_scale.h"
+
+// Full scale of the ADC input and one 12-bit code at the ADC, in uV
+#define ADC_FULL_SCALE_MICROVOLT  4300000
+#define ADC_LSB_MICROVOLT         (ADC_FULL_SCALE_MICROVOLT / 4096)
+
+static void checkRange(MultimeterMode mode, double divisor, double offset)
+{
+  uint32_t microVolt;
+  double maxError = 0;
+  double error;
+  double lsb = ADC_LSB_MICROVOLT / divisor;
+
+  for (microVolt = 0; microVolt <= ADC_FULL_SCALE_MICROVOLT; microVolt += 13)
+  {
+    error = fabs(MultimeterScale_apply(mode, microVolt) - (microVolt / divisor + offset));
+    if (error > maxError)
+    {
+      maxError = error;
+    }
+  }
+
+  printf("mode %d: max error %.2f units, one LSB is %.0f\n", mode, maxError, lsb);
+  CHECK(maxError <= lsb);
+  CHECK(maxError <= 2);
+}
+
+int main(void)
+{
+  uint32_t microVolt;
+
+  checkRange(MultimeterMode_10V, 0.3, 0);
+  checkRange(MultimeterMode_10VAC, 0.3, 0);
+  checkRange(MultimeterMode_500mA, 6.85, -1200);
+  checkRange(MultimeterMode_500mAAC, 6.85, 0);
+
+  // The unity ranges are exact
+  for (microVolt = 0; microVolt <= ADC_FULL_SCALE_MICROVOLT; microVolt += 997)
+  {
+    CHECK_EQ(MultimeterScale_apply(MultimeterMode_3V, microVolt), microVolt);
+    CHECK_EQ(MultimeterScale_apply(MultimeterMode_AutoV, microVolt), microVolt);
+  }
+
+  return (TEST_DONE());
+}
@@ -167,6 +167,26 @@ typedef enum CC1350_LAUNCHXL_ADCBufName {
     CC1350_LAUNCHXL_ADCBUFCOUNT
 } CC1350_LAUNCHXL_ADCBufName;
 
+/*!
+ *  @def    CC1350_LAUNCHXL_ADCBuf0ChannelName
+ *  @brief  Enum of ADCBuf channels
+ */
+typedef enum CC1350_LAUNCHXL_ADCBuf0ChannelName {
+    CC1350_LAUNCHXL_ADCBUF0CHANNEL0 = 0,
+    CC1350_LAUNCHXL_ADCBUF0CHANNEL1,
+    CC1350_LAUNCHXL_ADCBUF0CHANNEL2,
+    CC1350_LAUNCHXL_ADCBUF0CHANNEL3,
+    CC1350_LAUNCHXL_ADCBUF0CHANNEL4,
+    CC1350_LAUNCHXL_ADCBUF0CHANNEL5,
+    CC1350_LAUNCHXL_ADCBUF0CHANNEL6,
+    CC1350_LAUNCHXL_ADCBUF0CHANNEL7,
+    CC1350_LAUNCHXL_ADCBUF0CHANNELVDDS,
+    CC1350_LAUNCHXL_ADCBUF0CHANNELDCOUPL,
+    CC1350_LAUNCHXL_ADCBUF0CHANNELVSS,
+
+    CC1350_LAUNCHXL_ADCBUF0CHANNELCOUNT
+} CC1350_LAUNCHXL_ADCBuf0ChannelName;
+
 /*!
  *  @def    CC1350_LAUNCHXL_ADCName
  *  @brief  Enum of ADCs